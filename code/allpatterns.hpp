@@ -4,9 +4,28 @@
 #include "behavioral/command.hpp"
 #include "behavioral/interpreter.hpp"
 #include "behavioral/iterator.hpp"
+#include "behavioral/iterator_pipeline.hpp"
+#include "behavioral/concurrent_aggregate.hpp"
+#include "behavioral/mapped_aggregate.hpp"
 #include "behavioral/mediator.hpp"
+#include "behavioral/mediator_mailbox.hpp"
+#include "behavioral/sharded_mediator.hpp"
+#include "behavioral/chat_history.hpp"
+#include "behavioral/mediator_batching.hpp"
 #include "behavioral/memento.hpp"
+#include "behavioral/memento_delta.hpp"
+#include "behavioral/memento_tiered.hpp"
+#include "behavioral/memento_async.hpp"
 #include "behavioral/observer.hpp"
+#include "behavioral/observer_async.hpp"
+#include "behavioral/observer_filter.hpp"
+#include "behavioral/observer_throttle.hpp"
+#include "behavioral/signal_slot.hpp"
+#include "behavioral/station_registry.hpp"
+#include "behavioral/work_stealing_pool.hpp"
+#include "behavioral/window_stats.hpp"
+#include "behavioral/timeseries_store.hpp"
+#include "behavioral/state_machine.hpp"
 #include "behavioral/state.hpp"
 #include "behavioral/strategy.hpp"
 #include "behavioral/template_method.hpp"
@@ -0,0 +1,291 @@
+#include "chat_history.hpp"
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+std::int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::string segmentName(std::uint64_t baseOffset) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%020llu.log", static_cast<unsigned long long>(baseOffset));
+    return name;
+}
+
+}
+
+ChatHistoryLog::Segment::~Segment() {
+    if (data != nullptr) {
+        ::munmap(data, capacity);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+ChatHistoryLog::ChatHistoryLog(const std::string& directory, std::size_t segmentBytes,
+                               HistoryRetention retention)
+    : directory_(directory), segmentBytes_(segmentBytes), retention_(retention), nextOffset_(0) {
+    if (segmentBytes_ > kMaxSegmentBytes) {
+        throw std::invalid_argument("ChatHistoryLog: segments must be smaller than 4 GiB");
+    }
+    std::filesystem::create_directories(directory_);
+
+    // Reopen existing segments and rebuild their offset indexes
+    std::vector<std::uint64_t> baseOffsets;
+    for (const auto& file : std::filesystem::directory_iterator(directory_)) {
+        if (file.path().extension() == ".log") {
+            baseOffsets.push_back(std::stoull(file.path().stem().string()));
+        }
+    }
+    std::sort(baseOffsets.begin(), baseOffsets.end());
+
+    for (std::uint64_t baseOffset : baseOffsets) {
+        auto segment = openSegment(baseOffset, 0, false);
+        std::size_t position = 0;
+        while (position + sizeof(RecordHeader) <= segment->capacity) {
+            RecordHeader header;
+            std::memcpy(&header, segment->data + position, sizeof(header));
+            // Zeroes mark the end of the data; anything that does not fit
+            // is a torn write, and nothing after it can be trusted
+            std::size_t contents = sizeof(RecordHeader) + std::size_t(header.senderLength) + header.textLength;
+            if (header.length == 0 || header.length < contents || position + header.length > segment->capacity) {
+                break;
+            }
+            segment->positions.push_back(static_cast<std::uint32_t>(position));
+            segment->lastTimestampNanos = header.timestampNanos;
+            position += header.length;
+        }
+        segment->size = position;
+        nextOffset_ = baseOffset + segment->positions.size();
+        segments_.push_back(std::move(segment));
+    }
+
+    applyRetention();
+}
+
+ChatHistoryLog::~ChatHistoryLog() = default;
+
+std::unique_ptr<ChatHistoryLog::Segment> ChatHistoryLog::openSegment(std::uint64_t baseOffset,
+                                                                     std::size_t capacity,
+                                                                     bool create) {
+    auto segment = std::make_unique<Segment>();
+    segment->baseOffset = baseOffset;
+    segment->path = (std::filesystem::path(directory_) / segmentName(baseOffset)).string();
+
+    segment->fd = ::open(segment->path.c_str(), O_RDWR | (create ? O_CREAT | O_TRUNC : 0), 0644);
+    if (segment->fd < 0) {
+        throw std::runtime_error("Cannot open history segment: " + segment->path);
+    }
+    if (create) {
+        // Preallocated and zero-filled: a zero length marks the end of the data
+        if (::ftruncate(segment->fd, static_cast<off_t>(capacity)) != 0) {
+            throw std::runtime_error("Cannot size history segment: " + segment->path);
+        }
+    } else {
+        struct stat info;
+        if (::fstat(segment->fd, &info) != 0) {
+            throw std::runtime_error("Cannot stat history segment: " + segment->path);
+        }
+        if (static_cast<std::uint64_t>(info.st_size) > kMaxSegmentBytes) {
+            throw std::runtime_error("History segment larger than 4 GiB: " + segment->path);
+        }
+        capacity = static_cast<std::size_t>(info.st_size);
+    }
+    segment->capacity = capacity;
+
+    if (capacity > 0) {
+        void* mapping = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Cannot map history segment: " + segment->path);
+        }
+        segment->data = static_cast<char*>(mapping);
+    }
+    return segment;
+}
+
+std::uint64_t ChatHistoryLog::append(const std::string& sender, const std::string& text) {
+    std::size_t payload = sizeof(RecordHeader) + sender.size() + text.size();
+    std::size_t length = (payload + 7) & ~std::size_t(7);
+    if (length > kMaxSegmentBytes) {
+        throw std::length_error("ChatHistoryLog: message does not fit in a segment");
+    }
+
+    if (segments_.empty() || segments_.back()->size + length > segments_.back()->capacity) {
+        if (!segments_.empty() && segments_.back()->positions.empty()) {
+            // A reopened segment with no records has the name the new one
+            // gets; unmap it before the file is recreated
+            segments_.pop_back();
+        }
+        segments_.push_back(openSegment(nextOffset_, std::max(segmentBytes_, length), true));
+        applyRetention();
+    }
+
+    Segment& segment = *segments_.back();
+    RecordHeader header{static_cast<std::uint32_t>(length),
+                        static_cast<std::uint32_t>(sender.size()),
+                        static_cast<std::uint32_t>(text.size()), 0, nowNanos()};
+    char* record = segment.data + segment.size;
+    std::memcpy(record + sizeof(header), sender.data(), sender.size());
+    std::memcpy(record + sizeof(header) + sender.size(), text.data(), text.size());
+    std::memcpy(record, &header, sizeof(header));
+
+    segment.positions.push_back(static_cast<std::uint32_t>(segment.size));
+    segment.size += length;
+    segment.lastTimestampNanos = header.timestampNanos;
+    return nextOffset_++;
+}
+
+std::uint64_t ChatHistoryLog::getStartOffset() const {
+    return segments_.empty() ? nextOffset_ : segments_.front()->baseOffset;
+}
+
+std::size_t ChatHistoryLog::getSizeBytes() const {
+    std::size_t total = 0;
+    for (const auto& segment : segments_) {
+        total += segment->size;
+    }
+    return total;
+}
+
+void ChatHistoryLog::applyRetention() {
+    auto maxAgeNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(retention_.maxAge).count();
+    std::int64_t now = nowNanos();
+
+    // Budget against preallocated disk space, including the segment being
+    // written to, which is always kept
+    std::size_t footprint = 0;
+    for (const auto& segment : segments_) {
+        footprint += segment->capacity;
+    }
+    while (segments_.size() > 1) {
+        const Segment& oldest = *segments_.front();
+        bool tooBig = retention_.maxBytes > 0 && footprint > retention_.maxBytes;
+        bool tooOld = maxAgeNanos > 0 && now - oldest.lastTimestampNanos > maxAgeNanos;
+        if (!tooBig && !tooOld) {
+            break;
+        }
+        footprint -= oldest.capacity;
+        std::filesystem::remove(oldest.path);
+        segments_.erase(segments_.begin());
+    }
+}
+
+std::size_t ChatHistoryLog::findSegment(std::uint64_t offset) const {
+    auto it = std::upper_bound(segments_.begin(), segments_.end(), offset,
+        [](std::uint64_t value, const std::unique_ptr<Segment>& segment) {
+            return value < segment->baseOffset;
+        });
+    return it == segments_.begin() ? 0 : static_cast<std::size_t>(it - segments_.begin() - 1);
+}
+
+HistoryEntry ChatHistoryLog::entryAt(const Segment& segment, std::size_t index) {
+    const char* record = segment.data + segment.positions[index];
+    RecordHeader header;
+    std::memcpy(&header, record, sizeof(header));
+
+    const char* sender = record + sizeof(header);
+    return HistoryEntry{
+        segment.baseOffset + index,
+        std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(header.timestampNanos))),
+        std::string_view(sender, header.senderLength),
+        std::string_view(sender + header.senderLength, header.textLength)};
+}
+
+void HistoryChatRoom::addUserWithHistory(std::shared_ptr<Colleague> user, std::size_t lastMessages) {
+    log_.replayLast(lastMessages, [&user](const HistoryEntry& entry) { replayTo(*user, entry); });
+    addUser(std::move(user));
+}
+
+void HistoryChatRoom::addUserSince(std::shared_ptr<Colleague> user, std::uint64_t offset) {
+    log_.replaySince(offset, [&user](const HistoryEntry& entry) { replayTo(*user, entry); });
+    addUser(std::move(user));
+}
+
+void HistoryChatRoom::replayTo(Colleague& user, const HistoryEntry& entry) {
+    if (auto* reader = dynamic_cast<HistoryReader*>(&user)) {
+        reader->receiveHistory(entry);
+    } else {
+        user.receive(std::string(entry.text));
+    }
+}
+
+namespace {
+
+// Reads history in place instead of through receive()
+class Archiver : public User, public HistoryReader {
+public:
+    Archiver(Mediator* mediator, const std::string& name) : User(mediator, name) {}
+
+    void receiveHistory(const HistoryEntry& entry) override {
+        std::cout << name_ << " archives #" << entry.offset << " from " << entry.sender
+                  << ": " << entry.text << std::endl;
+    }
+};
+
+}
+
+void demonstrateChatHistory() {
+    std::cout << "\n=== Chat History Demo ===\n" << std::endl;
+
+    const auto directory = std::filesystem::temp_directory_path() / "chat_history_demo";
+    std::filesystem::remove_all(directory);
+    {
+        HistoryChatRoom room(directory.string());
+        auto alice = std::make_shared<User>(&room, "Alice");
+        auto bob = std::make_shared<User>(&room, "Bob");
+        room.addUser(alice);
+        room.addUser(bob);
+
+        alice->send("Hello Bob!");
+        bob->send("Hi Alice!");
+        alice->send("Where is Charlie?");
+
+        std::cout << "\nCharlie joins late and catches up on the last 2 messages:" << std::endl;
+        auto charlie = std::make_shared<User>(&room, "Charlie");
+        room.addUserWithHistory(charlie, 2);
+
+        std::cout << "\nAn archiver replays everything since offset 0:" << std::endl;
+        room.addUserSince(std::make_shared<Archiver>(&room, "Archiver"), 0);
+    }
+
+    std::cout << "\nRetention with 4 KB segments and an 8 KB budget:" << std::endl;
+    {
+        HistoryRetention retention;
+        retention.maxBytes = 8 << 10;
+        ChatHistoryLog log((directory / "bounded").string(), 4 << 10, retention);
+        for (int i = 0; i < 1000; ++i) {
+            log.append("bot", "message number " + std::to_string(i));
+        }
+        std::cout << "Appended 1000 messages, retained offsets " << log.getStartOffset()
+                  << " to " << log.getEndOffset() - 1 << " in " << log.getSegmentCount()
+                  << " segments (" << log.getSizeBytes() << " bytes)" << std::endl;
+    }
+    std::filesystem::remove_all(directory);
+
+    std::cout << "\n=== End Chat History Demo ===\n" << std::endl;
+}
+
+#else
+
+void demonstrateChatHistory() {
+    std::cout << "\n=== Chat History Demo ===\n" << std::endl;
+    std::cout << "The memory-mapped history log needs a POSIX platform" << std::endl;
+    std::cout << "\n=== End Chat History Demo ===\n" << std::endl;
+}
+
+#endif
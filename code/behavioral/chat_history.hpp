@@ -0,0 +1,162 @@
+#ifndef CHAT_HISTORY_HPP
+#define CHAT_HISTORY_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "mediator.hpp"
+
+// One logged message, viewed in place inside the log's mapped segment.
+// The views are only valid for the duration of the replay callback.
+struct HistoryEntry {
+    std::uint64_t offset;
+    std::chrono::system_clock::time_point timestamp;
+    std::string_view sender;
+    std::string_view text;
+};
+
+// Optional colleague interface: receives replayed history without copies.
+// Colleagues that don't implement it get a regular receive() per message.
+class HistoryReader {
+public:
+    virtual ~HistoryReader() = default;
+    virtual void receiveHistory(const HistoryEntry& entry) = 0;
+};
+
+// How much history a log keeps
+struct HistoryRetention {
+    std::size_t maxBytes = 0;          // 0 = unbounded
+    std::chrono::seconds maxAge{0};    // 0 = unbounded
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// Append-only message log split into memory-mapped segment files.
+//
+// Every message gets a sequential offset. Each segment file is named after
+// its first offset and keeps an in-memory index from offset to position, so
+// seeking to any offset is a binary search over segments plus one lookup.
+// Replays hand out views straight into the mapping. Whole segments are
+// deleted, oldest first, once the log exceeds its byte budget or their newest
+// message is older than the age limit. Not thread-safe, like ChatRoom.
+class ChatHistoryLog {
+public:
+    // Positions within a segment are 32-bit, so segments stay below 4 GiB
+    static constexpr std::size_t kMaxSegmentBytes = std::numeric_limits<std::uint32_t>::max();
+
+    // Throws std::invalid_argument if segmentBytes exceeds kMaxSegmentBytes
+    explicit ChatHistoryLog(const std::string& directory,
+                            std::size_t segmentBytes = 8 << 20,
+                            HistoryRetention retention = HistoryRetention());
+    ~ChatHistoryLog();
+
+    ChatHistoryLog(const ChatHistoryLog&) = delete;
+    ChatHistoryLog& operator=(const ChatHistoryLog&) = delete;
+
+    // Returns the offset assigned to the message. A message that would not
+    // fit in kMaxSegmentBytes throws std::length_error.
+    std::uint64_t append(const std::string& sender, const std::string& text);
+
+    // Oldest retained offset and the offset the next append will get
+    std::uint64_t getStartOffset() const;
+    std::uint64_t getEndOffset() const { return nextOffset_; }
+    std::size_t getSizeBytes() const;
+    std::size_t getSegmentCount() const { return segments_.size(); }
+
+    // Drops expired segments; also runs whenever a segment fills up
+    void applyRetention();
+
+    // Replays [offset, end); offsets older than the retained range start at
+    // the oldest retained message. Returns the number of messages replayed.
+    template<typename Fn>
+    std::size_t replaySince(std::uint64_t offset, Fn fn) const {
+        offset = std::max(offset, getStartOffset());
+        std::size_t replayed = 0;
+        for (std::size_t s = findSegment(offset); s < segments_.size(); ++s) {
+            const Segment& segment = *segments_[s];
+            for (std::size_t i = offset - segment.baseOffset; i < segment.positions.size(); ++i) {
+                fn(entryAt(segment, i));
+                ++replayed;
+            }
+            offset = segment.baseOffset + segment.positions.size();
+        }
+        return replayed;
+    }
+
+    template<typename Fn>
+    std::size_t replayLast(std::size_t count, Fn fn) const {
+        std::uint64_t start = nextOffset_ > count ? nextOffset_ - count : 0;
+        return replaySince(start, fn);
+    }
+
+private:
+    struct RecordHeader {
+        std::uint32_t length;        // whole record, header and padding included
+        std::uint32_t senderLength;
+        std::uint32_t textLength;
+        std::uint32_t reserved;
+        std::int64_t timestampNanos;
+    };
+
+    struct Segment {
+        std::uint64_t baseOffset = 0;
+        std::string path;
+        int fd = -1;
+        char* data = nullptr;
+        std::size_t capacity = 0;
+        std::size_t size = 0;
+        std::int64_t lastTimestampNanos = 0;
+        std::vector<std::uint32_t> positions;
+        ~Segment();
+    };
+
+    std::string directory_;
+    std::size_t segmentBytes_;
+    HistoryRetention retention_;
+    std::vector<std::unique_ptr<Segment>> segments_;
+    std::uint64_t nextOffset_;
+
+    std::unique_ptr<Segment> openSegment(std::uint64_t baseOffset, std::size_t capacity, bool create);
+    std::size_t findSegment(std::uint64_t offset) const;
+    static HistoryEntry entryAt(const Segment& segment, std::size_t index);
+};
+
+// Concrete Mediator: ChatRoom that logs every broadcast so late joiners can
+// catch up on what they missed
+class HistoryChatRoom : public ChatRoom {
+    ChatHistoryLog log_;
+public:
+    using ChatRoom::sendMessage;
+
+    explicit HistoryChatRoom(const std::string& directory,
+                             std::size_t segmentBytes = 8 << 20,
+                             HistoryRetention retention = HistoryRetention())
+        : log_(directory, segmentBytes, retention) {}
+
+    void sendMessage(const Message& message, Colleague* sender) override {
+        log_.append(message.getSender(), message.getText());
+        ChatRoom::sendMessage(message, sender);
+    }
+
+    // Adds the user after replaying the last lastMessages messages to it
+    void addUserWithHistory(std::shared_ptr<Colleague> user, std::size_t lastMessages);
+    // Adds the user after replaying everything from offset onwards
+    void addUserSince(std::shared_ptr<Colleague> user, std::uint64_t offset);
+
+    const ChatHistoryLog& getLog() const { return log_; }
+
+private:
+    static void replayTo(Colleague& user, const HistoryEntry& entry);
+};
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+void demonstrateChatHistory();
+
+#endif // CHAT_HISTORY_HPP
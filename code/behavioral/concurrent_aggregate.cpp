@@ -0,0 +1,128 @@
+#include "concurrent_aggregate.hpp"
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+void demonstrateConcurrentAggregate() {
+    std::cout << "\n=== Concurrent Aggregate Demo ===\n" << std::endl;
+
+    ConcurrentAggregate<int> aggregate;
+    aggregate.addItem(1);
+    aggregate.addItem(2);
+    aggregate.addItem(3);
+
+    // The iterator sees a snapshot of the three items above
+    auto iterator = aggregate.createIterator();
+    aggregate.addItem(4);
+    aggregate.addItem(5);
+
+    std::cout << "Iterator created before items 4 and 5 were added:" << std::endl;
+    for (iterator->first(); !iterator->isDone(); iterator->next()) {
+        std::cout << iterator->currentItem() << std::endl;
+    }
+    std::cout << "Aggregate now holds " << aggregate.getCount() << " items" << std::endl;
+
+    // One writer, several readers checking that every snapshot is consistent
+    const int total = 200'000;
+    ConcurrentAggregate<int> shared;
+    std::atomic<bool> done(false);
+    std::atomic<int> inconsistent(0);
+
+    std::thread writer([&]() {
+        for (int i = 0; i < total; ++i) {
+            shared.addItem(i);
+        }
+        done.store(true);
+    });
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                auto snapshot = shared.snapshot();
+                int expected = 0;
+                snapshot.forEach([&](int value) {
+                    if (value != expected++) {
+                        inconsistent++;
+                    }
+                });
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    std::cout << "\nWriter appended " << shared.getCount() << " items while 3 readers iterated"
+              << std::endl;
+    std::cout << "Inconsistent reads: " << inconsistent.load() << std::endl;
+
+    std::cout << "\n=== End Concurrent Aggregate Demo ===\n" << std::endl;
+}
+
+void benchmarkConcurrentAggregate(int readers, std::size_t items) {
+    std::cout << "\n=== Concurrent Aggregate Benchmark ===\n" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    ConcurrentAggregate<long long> aggregate;
+    std::atomic<bool> done(false);
+
+    // One cache line per reader, so the counters do not false-share
+    struct alignas(64) ReaderTally {
+        std::size_t itemsRead = 0;
+        std::size_t badSnapshots = 0;
+    };
+    std::vector<ReaderTally> tallies(static_cast<std::size_t>(readers));
+
+    auto start = Clock::now();
+    std::thread writer([&]() {
+        for (std::size_t i = 0; i < items; ++i) {
+            aggregate.addItem(static_cast<long long>(i));
+        }
+        done.store(true);
+    });
+    auto writerEnd = start;
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r]() {
+            ReaderTally tally;
+            while (!done.load(std::memory_order_relaxed)) {
+                auto snapshot = aggregate.snapshot();
+                long long sum = 0;
+                snapshot.forEach([&](long long value) { sum += value; });
+                // Items are 0..n-1; checking the sum also keeps the loop from being elided
+                auto count = static_cast<long long>(snapshot.getCount());
+                if (sum != count * (count - 1) / 2) {
+                    ++tally.badSnapshots;
+                }
+                tally.itemsRead += static_cast<std::size_t>(count);
+            }
+            tallies[static_cast<std::size_t>(r)] = tally;
+        });
+    }
+
+    writer.join();
+    writerEnd = Clock::now();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(writerEnd - start).count();
+    std::size_t totalRead = 0;
+    std::size_t badSnapshots = 0;
+    for (const auto& tally : tallies) {
+        totalRead += tally.itemsRead;
+        badSnapshots += tally.badSnapshots;
+    }
+
+    std::cout << "Items appended: " << items << " in " << seconds * 1000.0 << " ms ("
+              << static_cast<double>(items) / seconds / 1e6 << " M items/s)" << std::endl;
+    std::cout << "Readers: " << readers << ", items read: " << totalRead << " ("
+              << static_cast<double>(totalRead) / seconds / 1e6 << " M items/s), inconsistent snapshots: "
+              << badSnapshots << std::endl;
+
+    std::cout << "\n=== End Concurrent Aggregate Benchmark ===\n" << std::endl;
+}
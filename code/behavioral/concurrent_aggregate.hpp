@@ -0,0 +1,163 @@
+#ifndef CONCURRENT_AGGREGATE_HPP
+#define CONCURRENT_AGGREGATE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "iterator.hpp"
+
+// Forward declaration
+template<typename T>
+class SnapshotIterator;
+
+// Concurrent Aggregate: one writer appends while any number of readers iterate.
+//
+// Items live in fixed-size chunks that never move once allocated, so a reader
+// never sees a reallocation. The chunk directory is copy-on-write: when it
+// runs out of slots the writer builds a bigger copy and publishes it
+// atomically, and readers holding the old one keep using it. The item count
+// is published last with release ordering, so everything below it is fully
+// written. A Snapshot pins a directory plus a count and stays valid (and
+// unchanged) for as long as it is held, even after the aggregate is gone.
+//
+// Iterating a snapshot takes no locks. Taking one does: the directory is
+// published through std::atomic<std::shared_ptr>, which libstdc++ guards
+// with a lock, so snapshot() and directory growth briefly contend.
+//
+// addItem must only be called from one thread at a time.
+template<typename T>
+class ConcurrentAggregate : public Aggregate<T> {
+public:
+    static constexpr std::size_t kChunkSize = 4096;
+
+private:
+    struct Chunk {
+        std::unique_ptr<T[]> items;
+        Chunk() : items(new T[kChunkSize]) {}
+    };
+
+    // Slots at or beyond the published count are only touched by the writer
+    struct Directory {
+        std::vector<std::shared_ptr<Chunk>> chunks;
+        explicit Directory(std::size_t capacity) : chunks(capacity) {}
+    };
+
+    std::atomic<std::shared_ptr<Directory>> directory_;
+    std::atomic<std::size_t> count_;
+    std::shared_ptr<Directory> writerDirectory_;
+
+public:
+    // Snapshot: a stable, read-only view of the first getCount() items
+    class Snapshot {
+        std::shared_ptr<const Directory> directory_;
+        std::size_t count_;
+    public:
+        Snapshot() : count_(0) {}
+        Snapshot(std::shared_ptr<const Directory> directory, std::size_t count)
+            : directory_(std::move(directory)), count_(count) {}
+
+        T getItem(int index) const {
+            if (index >= 0 && static_cast<std::size_t>(index) < count_) {
+                std::size_t i = static_cast<std::size_t>(index);
+                return directory_->chunks[i / kChunkSize]->items[i % kChunkSize];
+            }
+            return T{};
+        }
+
+        int getCount() const {
+            return static_cast<int>(count_);
+        }
+
+        // Visits every item chunk by chunk, without per-item bounds checks
+        template<typename Fn>
+        void forEach(Fn fn) const {
+            for (std::size_t base = 0; base < count_; base += kChunkSize) {
+                const T* items = directory_->chunks[base / kChunkSize]->items.get();
+                std::size_t end = std::min(kChunkSize, count_ - base);
+                for (std::size_t i = 0; i < end; ++i) {
+                    fn(items[i]);
+                }
+            }
+        }
+    };
+
+    ConcurrentAggregate()
+        : count_(0), writerDirectory_(std::make_shared<Directory>(16)) {
+        directory_.store(writerDirectory_, std::memory_order_release);
+    }
+
+    void addItem(const T& item) {
+        std::size_t count = count_.load(std::memory_order_relaxed);
+        std::size_t chunk = count / kChunkSize;
+
+        if (count % kChunkSize == 0) {
+            if (chunk == writerDirectory_->chunks.size()) {
+                // Copy-on-write: readers keep the old directory alive
+                auto grown = std::make_shared<Directory>(chunk * 2);
+                std::copy(writerDirectory_->chunks.begin(), writerDirectory_->chunks.end(),
+                          grown->chunks.begin());
+                writerDirectory_ = grown;
+            }
+            writerDirectory_->chunks[chunk] = std::make_shared<Chunk>();
+            directory_.store(writerDirectory_, std::memory_order_release);
+        }
+
+        writerDirectory_->chunks[chunk]->items[count % kChunkSize] = item;
+        count_.store(count + 1, std::memory_order_release);
+    }
+
+    int getCount() const {
+        return static_cast<int>(count_.load(std::memory_order_acquire));
+    }
+
+    Snapshot snapshot() const {
+        // Count first: any directory loaded afterwards covers it
+        std::size_t count = count_.load(std::memory_order_acquire);
+        return Snapshot(directory_.load(std::memory_order_acquire), count);
+    }
+
+    std::unique_ptr<Iterator<T>> createIterator() override;
+};
+
+// Snapshot Iterator: walks the items that existed when it was created
+template<typename T>
+class SnapshotIterator : public Iterator<T> {
+    typename ConcurrentAggregate<T>::Snapshot snapshot_;
+    int current_;
+public:
+    explicit SnapshotIterator(typename ConcurrentAggregate<T>::Snapshot snapshot)
+        : snapshot_(std::move(snapshot)), current_(0) {}
+
+    T first() override {
+        current_ = 0;
+        return snapshot_.getItem(current_);
+    }
+
+    T next() override {
+        current_++;
+        if (current_ < snapshot_.getCount()) {
+            return snapshot_.getItem(current_);
+        }
+        return T{};
+    }
+
+    bool isDone() const override {
+        return current_ >= snapshot_.getCount();
+    }
+
+    T currentItem() const override {
+        return snapshot_.getItem(current_);
+    }
+};
+
+template<typename T>
+std::unique_ptr<Iterator<T>> ConcurrentAggregate<T>::createIterator() {
+    return std::make_unique<SnapshotIterator<T>>(snapshot());
+}
+
+void demonstrateConcurrentAggregate();
+void benchmarkConcurrentAggregate(int readers = 4, std::size_t items = 10'000'000);
+
+#endif // CONCURRENT_AGGREGATE_HPP
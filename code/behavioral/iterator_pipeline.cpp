@@ -0,0 +1,104 @@
+#include "iterator_pipeline.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+void demonstrateIteratorPipeline() {
+    std::cout << "\n=== Iterator Pipeline Demo ===\n" << std::endl;
+
+    ConcreteAggregate<int> numbers;
+    for (int i = 1; i <= 20; ++i) {
+        numbers.addItem(i);
+    }
+
+    ConcreteAggregate<std::string> names;
+    names.addItem("one");
+    names.addItem("two");
+    names.addItem("three");
+
+    // Nothing runs here, the pipeline is just a description
+    auto evensSquared = makePipeline(numbers)
+        .filter([](int n) { return n % 2 == 0; })
+        .map([](int n) { return n * n; })
+        .take(5);
+
+    std::cout << "First five even squares:";
+    evensSquared.forEach([](int n) { std::cout << " " << n; });
+    std::cout << std::endl;
+
+    std::cout << "Sum of those squares: "
+              << evensSquared.reduce(0, [](int acc, int n) { return acc + n; }) << std::endl;
+
+    std::cout << "Zipped with names:" << std::endl;
+    makePipeline(numbers).zip(makePipeline(names)).forEach([](const auto& pair) {
+        std::cout << "  " << pair.first << " -> " << pair.second << std::endl;
+    });
+
+    std::cout << "Chunks of 6:" << std::endl;
+    makePipeline(numbers).chunk<6>().forEach([](const auto& chunk) {
+        std::cout << " ";
+        for (int n : chunk) {
+            std::cout << " " << n;
+        }
+        std::cout << std::endl;
+    });
+
+    // Works over any Aggregate through its iterator too
+    auto iterator = names.createIterator();
+    std::cout << "Names longer than three letters: "
+              << makePipeline(*iterator)
+                     .filter([](const std::string& s) { return s.size() > 3; })
+                     .count()
+              << std::endl;
+
+    std::cout << "\n=== End Iterator Pipeline Demo ===\n" << std::endl;
+}
+
+void benchmarkIteratorPipeline(std::size_t elements) {
+    std::cout << "\n=== Iterator Pipeline Benchmark ===\n" << std::endl;
+
+    ConcreteAggregate<int> numbers;
+    for (std::size_t i = 0; i < elements; ++i) {
+        numbers.addItem(static_cast<int>(i));
+    }
+    const std::size_t limit = elements / 4;
+
+    using Clock = std::chrono::steady_clock;
+
+    // Eager: every stage materializes a new vector
+    auto eagerStart = Clock::now();
+    std::vector<int> evens;
+    for (int i = 0; i < numbers.getCount(); ++i) {
+        int n = numbers.getItem(i);
+        if (n % 2 == 0) evens.push_back(n);
+    }
+    std::vector<long long> tripled;
+    for (int n : evens) tripled.push_back(static_cast<long long>(n) * 3);
+    std::vector<long long> notFives;
+    for (long long n : tripled) if (n % 5 != 0) notFives.push_back(n);
+    std::vector<long long> shifted;
+    for (long long n : notFives) shifted.push_back(n + 1);
+    std::vector<long long> limited(shifted.begin(),
+        shifted.begin() + static_cast<std::ptrdiff_t>(std::min(limit, shifted.size())));
+    long long eagerSum = 0;
+    for (long long n : limited) eagerSum += n;
+    auto eagerTime = std::chrono::duration<double, std::milli>(Clock::now() - eagerStart);
+
+    // Lazy: the same five stages fused into one pass
+    auto lazyStart = Clock::now();
+    long long lazySum = makePipeline(numbers)
+        .filter([](int n) { return n % 2 == 0; })
+        .map([](int n) { return static_cast<long long>(n) * 3; })
+        .filter([](long long n) { return n % 5 != 0; })
+        .map([](long long n) { return n + 1; })
+        .take(limit)
+        .reduce(0LL, [](long long acc, long long n) { return acc + n; });
+    auto lazyTime = std::chrono::duration<double, std::milli>(Clock::now() - lazyStart);
+
+    std::cout << "Elements: " << elements << std::endl;
+    std::cout << "Eager: " << eagerTime.count() << " ms (sum " << eagerSum << ")" << std::endl;
+    std::cout << "Lazy:  " << lazyTime.count() << " ms (sum " << lazySum << ")" << std::endl;
+
+    std::cout << "\n=== End Iterator Pipeline Benchmark ===\n" << std::endl;
+}
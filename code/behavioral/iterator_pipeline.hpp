@@ -0,0 +1,275 @@
+#ifndef ITERATOR_PIPELINE_HPP
+#define ITERATOR_PIPELINE_HPP
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "iterator.hpp"
+
+// Lazy pipelines over aggregates.
+//
+// Every stage exposes a single pull() that returns the next value or
+// std::nullopt when exhausted. Stages are stored by value inside each other,
+// so a chain like source.filter().map().take() is one object whose pull()
+// the compiler can inline into a single loop. Nothing is computed or
+// allocated until a terminal operation (forEach, reduce, count, collect) runs.
+
+// Source: reads a ConcreteAggregate by index, no iterator allocation needed
+template<typename T>
+class AggregateSource {
+    const ConcreteAggregate<T>* aggregate_;
+    int index_;
+public:
+    using value_type = T;
+
+    explicit AggregateSource(const ConcreteAggregate<T>& aggregate)
+        : aggregate_(&aggregate), index_(0) {}
+
+    std::optional<T> pull() {
+        if (index_ < aggregate_->getCount()) {
+            return aggregate_->getItem(index_++);
+        }
+        return std::nullopt;
+    }
+};
+
+// Source: adapts any Iterator<T>, so pipelines work over every Aggregate<T>.
+// Copies of this source share the underlying iterator.
+template<typename T>
+class IteratorSource {
+    Iterator<T>* iterator_;
+    bool started_;
+public:
+    using value_type = T;
+
+    explicit IteratorSource(Iterator<T>& iterator)
+        : iterator_(&iterator), started_(false) {}
+
+    std::optional<T> pull() {
+        if (!started_) {
+            iterator_->first();
+            started_ = true;
+        } else {
+            iterator_->next();
+        }
+        if (iterator_->isDone()) {
+            return std::nullopt;
+        }
+        return iterator_->currentItem();
+    }
+};
+
+// Stage: keeps values matching a predicate
+template<typename Source, typename Pred>
+class FilterStage {
+    Source source_;
+    Pred pred_;
+public:
+    using value_type = typename Source::value_type;
+
+    FilterStage(Source source, Pred pred)
+        : source_(std::move(source)), pred_(std::move(pred)) {}
+
+    std::optional<value_type> pull() {
+        while (auto item = source_.pull()) {
+            if (pred_(*item)) {
+                return item;
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+// Stage: transforms each value
+template<typename Source, typename Fn>
+class MapStage {
+    Source source_;
+    Fn fn_;
+public:
+    using value_type = std::remove_cvref_t<
+        std::invoke_result_t<Fn&, typename Source::value_type&&>>;
+
+    MapStage(Source source, Fn fn)
+        : source_(std::move(source)), fn_(std::move(fn)) {}
+
+    std::optional<value_type> pull() {
+        if (auto item = source_.pull()) {
+            return fn_(std::move(*item));
+        }
+        return std::nullopt;
+    }
+};
+
+// Stage: stops after a fixed number of values
+template<typename Source>
+class TakeStage {
+    Source source_;
+    std::size_t remaining_;
+public:
+    using value_type = typename Source::value_type;
+
+    TakeStage(Source source, std::size_t count)
+        : source_(std::move(source)), remaining_(count) {}
+
+    std::optional<value_type> pull() {
+        if (remaining_ == 0) {
+            return std::nullopt;
+        }
+        --remaining_;
+        return source_.pull();
+    }
+};
+
+// Stage: pairs values from two sources, ends with the shorter one
+template<typename Left, typename Right>
+class ZipStage {
+    Left left_;
+    Right right_;
+public:
+    using value_type = std::pair<typename Left::value_type, typename Right::value_type>;
+
+    ZipStage(Left left, Right right)
+        : left_(std::move(left)), right_(std::move(right)) {}
+
+    std::optional<value_type> pull() {
+        auto left = left_.pull();
+        if (!left) {
+            return std::nullopt;
+        }
+        auto right = right_.pull();
+        if (!right) {
+            return std::nullopt;
+        }
+        return value_type(std::move(*left), std::move(*right));
+    }
+};
+
+// Fixed-capacity chunk; the last one of a sequence may be partially filled
+template<typename T, std::size_t N>
+struct PipelineChunk {
+    std::array<T, N> items{};
+    std::size_t size = 0;
+
+    const T* begin() const { return items.data(); }
+    const T* end() const { return items.data() + size; }
+};
+
+// Stage: groups consecutive values into chunks of N
+template<typename Source, std::size_t N>
+class ChunkStage {
+    static_assert(N > 0, "Chunk size must be positive");
+    Source source_;
+public:
+    using value_type = PipelineChunk<typename Source::value_type, N>;
+
+    explicit ChunkStage(Source source) : source_(std::move(source)) {}
+
+    std::optional<value_type> pull() {
+        value_type chunk;
+        while (chunk.size < N) {
+            auto item = source_.pull();
+            if (!item) {
+                break;
+            }
+            chunk.items[chunk.size++] = std::move(*item);
+        }
+        if (chunk.size == 0) {
+            return std::nullopt;
+        }
+        return chunk;
+    }
+};
+
+// Pipeline: fluent wrapper that builds stages and runs terminal operations.
+// A pipeline is only a description; each terminal operation runs on a fresh
+// copy of the stages, so the same pipeline can be evaluated more than once.
+template<typename Source>
+class Pipeline {
+    Source source_;
+public:
+    using value_type = typename Source::value_type;
+
+    explicit Pipeline(Source source) : source_(std::move(source)) {}
+
+    std::optional<value_type> pull() {
+        return source_.pull();
+    }
+
+    template<typename Pred>
+    auto filter(Pred pred) const {
+        return Pipeline<FilterStage<Source, Pred>>(
+            FilterStage<Source, Pred>(source_, std::move(pred)));
+    }
+
+    template<typename Fn>
+    auto map(Fn fn) const {
+        return Pipeline<MapStage<Source, Fn>>(
+            MapStage<Source, Fn>(source_, std::move(fn)));
+    }
+
+    auto take(std::size_t count) const {
+        return Pipeline<TakeStage<Source>>(TakeStage<Source>(source_, count));
+    }
+
+    template<typename Other>
+    auto zip(const Pipeline<Other>& other) const {
+        return Pipeline<ZipStage<Source, Pipeline<Other>>>(
+            ZipStage<Source, Pipeline<Other>>(source_, other));
+    }
+
+    template<std::size_t N>
+    auto chunk() const {
+        return Pipeline<ChunkStage<Source, N>>(ChunkStage<Source, N>(source_));
+    }
+
+    // Terminal operations
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        Source source = source_;
+        while (auto item = source.pull()) {
+            fn(*item);
+        }
+    }
+
+    template<typename Acc, typename Fn>
+    Acc reduce(Acc init, Fn fn) const {
+        Source source = source_;
+        while (auto item = source.pull()) {
+            init = fn(std::move(init), std::move(*item));
+        }
+        return init;
+    }
+
+    std::size_t count() const {
+        Source source = source_;
+        std::size_t total = 0;
+        while (source.pull()) {
+            ++total;
+        }
+        return total;
+    }
+
+    std::vector<value_type> collect() const {
+        std::vector<value_type> result;
+        forEach([&result](const value_type& item) { result.push_back(item); });
+        return result;
+    }
+};
+
+template<typename T>
+Pipeline<AggregateSource<T>> makePipeline(const ConcreteAggregate<T>& aggregate) {
+    return Pipeline<AggregateSource<T>>(AggregateSource<T>(aggregate));
+}
+
+template<typename T>
+Pipeline<IteratorSource<T>> makePipeline(Iterator<T>& iterator) {
+    return Pipeline<IteratorSource<T>>(IteratorSource<T>(iterator));
+}
+
+void demonstrateIteratorPipeline();
+void benchmarkIteratorPipeline(std::size_t elements = 50'000'000);
+
+#endif // ITERATOR_PIPELINE_HPP
@@ -0,0 +1,101 @@
+#include "mapped_aggregate.hpp"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <sys/resource.h>
+
+namespace {
+
+struct Reading {
+    long long timestamp;
+    double value;
+};
+
+long peakResidentKilobytes() {
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+}
+
+void demonstrateMappedAggregate() {
+    std::cout << "\n=== Mapped Aggregate Demo ===\n" << std::endl;
+
+    const std::string path = "mapped_aggregate_demo.bin";
+    {
+        MappedAggregate<Reading> readings(path, true);
+        for (int i = 0; i < 5; ++i) {
+            readings.addItem(Reading{1000LL + i, 20.0 + i * 0.5});
+        }
+
+        std::cout << "Readings stored on disk: " << readings.getCount() << std::endl;
+        auto iterator = readings.createIterator();
+        for (iterator->first(); !iterator->isDone(); iterator->next()) {
+            Reading reading = iterator->currentItem();
+            std::cout << "  t=" << reading.timestamp << " value=" << reading.value << std::endl;
+        }
+    }
+
+    // Reopening the file keeps the existing items
+    {
+        MappedAggregate<Reading> reopened(path);
+        std::cout << "Readings after reopening: " << reopened.getCount() << std::endl;
+        std::cout << "Last reading value: " << reopened.getItem(reopened.getCount() - 1).value
+                  << std::endl;
+    }
+    std::remove(path.c_str());
+
+    std::cout << "\n=== End Mapped Aggregate Demo ===\n" << std::endl;
+}
+
+void benchmarkMappedAggregate(const std::string& path, std::size_t megabytes) {
+    std::cout << "\n=== Mapped Aggregate Benchmark ===\n" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    const std::size_t items = megabytes * (1 << 20) / sizeof(long long);
+
+    MappedAggregate<long long> aggregate(path, true);
+    auto writeStart = Clock::now();
+    for (std::size_t i = 0; i < items; ++i) {
+        aggregate.addItem(static_cast<long long>(i));
+    }
+    aggregate.flush();
+    double writeSeconds = std::chrono::duration<double>(Clock::now() - writeStart).count();
+
+    auto readStart = Clock::now();
+    long long checksum = 0;
+    auto iterator = aggregate.createIterator();
+    for (iterator->first(); !iterator->isDone(); iterator->next()) {
+        checksum += iterator->currentItem();
+    }
+    double readSeconds = std::chrono::duration<double>(Clock::now() - readStart).count();
+
+    std::cout << "File size: " << megabytes << " MB (" << items << " items)" << std::endl;
+    std::cout << "Append: " << static_cast<double>(megabytes) / writeSeconds << " MB/s" << std::endl;
+    std::cout << "Scan:   " << static_cast<double>(megabytes) / readSeconds << " MB/s (checksum "
+              << checksum << ")" << std::endl;
+    std::cout << "Peak resident memory: " << peakResidentKilobytes() / 1024 << " MB" << std::endl;
+
+    iterator.reset();
+    std::remove(path.c_str());
+
+    std::cout << "\n=== End Mapped Aggregate Benchmark ===\n" << std::endl;
+}
+
+#else
+
+void demonstrateMappedAggregate() {
+    std::cout << "\n=== Mapped Aggregate Demo ===\n" << std::endl;
+    std::cout << "Memory-mapped aggregates need a POSIX platform" << std::endl;
+    std::cout << "\n=== End Mapped Aggregate Demo ===\n" << std::endl;
+}
+
+void benchmarkMappedAggregate(const std::string&, std::size_t) {
+    demonstrateMappedAggregate();
+}
+
+#endif
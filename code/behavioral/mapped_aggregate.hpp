@@ -0,0 +1,249 @@
+#ifndef MAPPED_AGGREGATE_HPP
+#define MAPPED_AGGREGATE_HPP
+
+#include <cstddef>
+#include <string>
+#include "iterator.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Forward declaration
+template<typename T>
+class MappedIterator;
+
+// Mapped Aggregate: out-of-core storage for trivially copyable items.
+//
+// Items are appended through a small write buffer that is streamed to the end
+// of the file, and read back through MappedIterator, which maps the file one
+// window at a time and asks the kernel to read the next window ahead of the
+// cursor. Resident memory is bounded by the write buffer plus one window,
+// whatever the size of the file. Counts are 64-bit since datasets this size
+// outgrow int.
+template<typename T>
+class MappedAggregate : public Aggregate<T> {
+    static_assert(std::is_trivially_copyable_v<T>, "MappedAggregate requires trivially copyable items");
+
+    int fd_;
+    std::size_t flushedCount_;
+    std::vector<T> buffer_;
+    std::size_t bufferCapacity_;
+
+    friend class MappedIterator<T>;
+
+public:
+    static constexpr std::size_t kDefaultBufferBytes = 1 << 20;
+
+    // Opens (or creates) the file; existing items are kept and appended to
+    explicit MappedAggregate(const std::string& path, bool truncate = false,
+                             std::size_t bufferBytes = kDefaultBufferBytes)
+        : fd_(-1), flushedCount_(0),
+          bufferCapacity_(std::max<std::size_t>(1, bufferBytes / sizeof(T))) {
+        int flags = O_RDWR | O_CREAT | (truncate ? O_TRUNC : 0);
+        fd_ = ::open(path.c_str(), flags, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error("Cannot open mapped aggregate file: " + path);
+        }
+        struct stat info;
+        if (::fstat(fd_, &info) != 0) {
+            ::close(fd_);
+            throw std::runtime_error("Cannot stat mapped aggregate file: " + path);
+        }
+        flushedCount_ = static_cast<std::size_t>(info.st_size) / sizeof(T);
+        buffer_.reserve(bufferCapacity_);
+    }
+
+    MappedAggregate(const MappedAggregate&) = delete;
+    MappedAggregate& operator=(const MappedAggregate&) = delete;
+
+    ~MappedAggregate() override {
+        try {
+            flush();
+        } catch (...) {
+        }
+        ::close(fd_);
+    }
+
+    void addItem(const T& item) {
+        buffer_.push_back(item);
+        if (buffer_.size() == bufferCapacity_) {
+            flush();
+        }
+    }
+
+    // Streams buffered items to the end of the file; short writes are
+    // continued and interrupted ones retried
+    void flush() {
+        const char* data = reinterpret_cast<const char*>(buffer_.data());
+        std::size_t remaining = buffer_.size() * sizeof(T);
+        off_t offset = static_cast<off_t>(flushedCount_ * sizeof(T));
+        while (remaining > 0) {
+            ssize_t written = ::pwrite(fd_, data, remaining, offset);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                throw std::runtime_error("Write to mapped aggregate file failed");
+            }
+            data += written;
+            offset += written;
+            remaining -= static_cast<std::size_t>(written);
+        }
+        flushedCount_ += buffer_.size();
+        buffer_.clear();
+    }
+
+    std::size_t getCount() const {
+        return flushedCount_ + buffer_.size();
+    }
+
+    // Random access; prefer the iterator for scans
+    T getItem(std::size_t index) const {
+        T item{};
+        if (index < flushedCount_) {
+            char* data = reinterpret_cast<char*>(&item);
+            std::size_t remaining = sizeof(T);
+            off_t offset = static_cast<off_t>(index * sizeof(T));
+            while (remaining > 0) {
+                ssize_t bytesRead = ::pread(fd_, data, remaining, offset);
+                if (bytesRead < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (bytesRead <= 0) {
+                    // Zero means the file was truncated under us
+                    throw std::runtime_error("Read from mapped aggregate file failed");
+                }
+                data += bytesRead;
+                offset += bytesRead;
+                remaining -= static_cast<std::size_t>(bytesRead);
+            }
+        } else if (index < getCount()) {
+            item = buffer_[index - flushedCount_];
+        }
+        return item;
+    }
+
+    // Flushes first so the iterator only ever reads through the mapping
+    std::unique_ptr<Iterator<T>> createIterator() override {
+        flush();
+        return std::make_unique<MappedIterator<T>>(this);
+    }
+};
+
+// Mapped Iterator: sequential scan through a sliding mapped window
+template<typename T>
+class MappedIterator : public Iterator<T> {
+    const MappedAggregate<T>* aggregate_;
+    std::size_t count_;
+    std::size_t itemsPerWindow_;
+    std::size_t current_;
+    // The current window is remapped lazily from currentItem()
+    mutable std::size_t windowFirst_;
+    mutable std::size_t windowEnd_;
+    mutable void* mapping_;
+    mutable std::size_t mappingLength_;
+    mutable const char* windowItems_;
+
+public:
+    static constexpr std::size_t kDefaultWindowBytes = 64 << 20;
+
+    explicit MappedIterator(const MappedAggregate<T>* aggregate,
+                            std::size_t windowBytes = kDefaultWindowBytes)
+        : aggregate_(aggregate), count_(aggregate->flushedCount_),
+          itemsPerWindow_(std::max<std::size_t>(1, windowBytes / sizeof(T))),
+          current_(0), windowFirst_(0), windowEnd_(0),
+          mapping_(nullptr), mappingLength_(0), windowItems_(nullptr) {}
+
+    MappedIterator(const MappedIterator&) = delete;
+    MappedIterator& operator=(const MappedIterator&) = delete;
+
+    ~MappedIterator() override {
+        unmapWindow();
+    }
+
+    T first() override {
+        current_ = 0;
+        return currentItem();
+    }
+
+    T next() override {
+        current_++;
+        return currentItem();
+    }
+
+    bool isDone() const override {
+        return current_ >= count_;
+    }
+
+    T currentItem() const override {
+        T item{};
+        if (current_ < count_) {
+            if (current_ < windowFirst_ || current_ >= windowEnd_) {
+                mapWindow(current_ / itemsPerWindow_);
+            }
+            std::memcpy(&item, windowItems_ + (current_ - windowFirst_) * sizeof(T), sizeof(T));
+        }
+        return item;
+    }
+
+private:
+    void mapWindow(std::size_t window) const {
+        unmapWindow();
+
+        static const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        windowFirst_ = window * itemsPerWindow_;
+        windowEnd_ = std::min(count_, windowFirst_ + itemsPerWindow_);
+        std::size_t byteBegin = windowFirst_ * sizeof(T);
+        std::size_t byteEnd = windowEnd_ * sizeof(T);
+        std::size_t mapBegin = byteBegin - byteBegin % pageSize;
+        mappingLength_ = byteEnd - mapBegin;
+
+        mapping_ = ::mmap(nullptr, mappingLength_, PROT_READ, MAP_SHARED,
+                          aggregate_->fd_, static_cast<off_t>(mapBegin));
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            throw std::runtime_error("Cannot map mapped aggregate window");
+        }
+        ::madvise(mapping_, mappingLength_, MADV_SEQUENTIAL);
+        ::madvise(mapping_, mappingLength_, MADV_WILLNEED);
+        windowItems_ = static_cast<const char*>(mapping_) + (byteBegin - mapBegin);
+
+        // Readahead for the window after this one, before the cursor gets there
+#if defined(POSIX_FADV_WILLNEED)
+        if (windowEnd_ < count_) {
+            std::size_t aheadEnd = std::min(count_, windowEnd_ + itemsPerWindow_);
+            ::posix_fadvise(aggregate_->fd_, static_cast<off_t>(byteEnd),
+                            static_cast<off_t>((aheadEnd - windowEnd_) * sizeof(T)),
+                            POSIX_FADV_WILLNEED);
+        }
+#endif
+    }
+
+    void unmapWindow() const {
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, mappingLength_);
+            mapping_ = nullptr;
+            windowItems_ = nullptr;
+            windowFirst_ = windowEnd_ = 0;
+        }
+    }
+};
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+void demonstrateMappedAggregate();
+void benchmarkMappedAggregate(const std::string& path = "mapped_aggregate.bin",
+                              std::size_t megabytes = 1024);
+
+#endif // MAPPED_AGGREGATE_HPP
@@ -1,4 +1,5 @@
 #include "mediator.hpp"
+#include <algorithm>
 #include <iostream>
 
 void demonstrateMediatorPattern() {
@@ -23,5 +24,72 @@ void demonstrateMediatorPattern() {
     bob->send("Hi Alice!");
     charlie->send("Hello from Charlie!");
 
+    // Directed and topic messages only reach their recipients
+    std::cout << "\nDirected and topic messages:" << std::endl;
+    chatRoom->subscribe("sports", bob.get());
+    chatRoom->subscribe("sports", charlie.get());
+    alice->sendTo("Bob", "Just between us");
+    alice->publish("sports", "Match starts at 8");
+    chatRoom->unsubscribe("sports", charlie.get());
+    bob->publish("sports", "Charlie left the topic");
+
     std::cout << "\n=== End Mediator Pattern Demo ===\n" << std::endl;
-} 
\ No newline at end of file
+} 
+
+namespace {
+
+// Keeps its own copy of every message, like a per-recipient string copy
+class CopyingColleague : public Colleague {
+    std::string last_;
+public:
+    CopyingColleague(Mediator* mediator, const std::string& name) : Colleague(mediator, name) {}
+    void send(const std::string& message) override { mediator_->sendMessage(message, this); }
+    void receive(const std::string& message) override { last_ = message; }
+};
+
+// Keeps a reference to the shared buffer instead
+class SharingColleague : public Colleague {
+    Message last_;
+public:
+    SharingColleague(Mediator* mediator, const std::string& name)
+        : Colleague(mediator, name), last_(name, std::string()) {}
+    void send(const std::string& message) override { mediator_->sendMessage(message, this); }
+    void receive(const std::string&) override {}
+    void receive(const Message& message) override { last_ = message; }
+};
+
+template<typename ColleagueType>
+double measureBroadcast(int users, int broadcasts, const std::string& text) {
+    ChatRoom room;
+    std::vector<std::shared_ptr<ColleagueType>> colleagues;
+    for (int i = 0; i < users; ++i) {
+        auto colleague = std::make_shared<ColleagueType>(&room, "user" + std::to_string(i));
+        colleagues.push_back(colleague);
+        room.addUser(colleague);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < broadcasts; ++i) {
+        colleagues[0]->send(text);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / broadcasts;
+}
+
+}
+
+void benchmarkMediatorBroadcast() {
+    std::cout << "\n=== Mediator Broadcast Benchmark ===\n" << std::endl;
+
+    const std::string text(1024, 'x');
+    for (int users : {10, 1'000, 100'000}) {
+        int broadcasts = std::max(1, 10'000'000 / users);
+        double copying = measureBroadcast<CopyingColleague>(users, broadcasts, text);
+        double sharing = measureBroadcast<SharingColleague>(users, broadcasts, text);
+        std::cout << users << " users: copy per recipient " << copying / 1000.0
+                  << " us/broadcast, shared buffer " << sharing / 1000.0 << " us/broadcast"
+                  << std::endl;
+    }
+
+    std::cout << "\n=== End Mediator Broadcast Benchmark ===\n" << std::endl;
+}
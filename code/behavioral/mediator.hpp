@@ -1,20 +1,91 @@
 #ifndef MEDIATOR_HPP
 #define MEDIATOR_HPP
 
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
+#include <span>
+#include <algorithm>
 
 // Forward declarations
 class Colleague;
 class ChatRoom;
 
+// Message: immutable, reference-counted payload built once per send.
+// Copying a Message only bumps a reference count, so a broadcast hands the
+// same buffer to every recipient, and recipients may keep it around.
+class Message {
+    struct Payload {
+        std::string sender;
+        std::string text;
+        std::chrono::steady_clock::time_point sentAt;
+    };
+    std::shared_ptr<const Payload> payload_;
+public:
+    Message(const std::string& sender, std::string text)
+        : payload_(std::make_shared<const Payload>(
+              Payload{sender, std::move(text), std::chrono::steady_clock::now()})) {}
+
+    const std::string& getSender() const { return payload_->sender; }
+    const std::string& getText() const { return payload_->text; }
+    std::chrono::steady_clock::time_point getSentAt() const { return payload_->sentAt; }
+    long getShareCount() const { return payload_.use_count(); }
+};
+
 // Mediator interface
 class Mediator {
 public:
     virtual ~Mediator() = default;
-    virtual void sendMessage(const std::string& message, Colleague* sender) = 0;
+    virtual void sendMessage(const Message& message, Colleague* sender) = 0;
+
+    // Convenience overload: wraps the text in a Message once
+    void sendMessage(const std::string& message, Colleague* sender);
+
+    // Directed delivery to the colleague with the given name, and delivery
+    // to every subscriber of a topic; the sender never receives its own message
+    virtual void sendMessageTo(const std::string& recipient, const Message& message, Colleague* sender) = 0;
+    virtual void publishMessage(const std::string& topic, const Message& message, Colleague* sender) = 0;
+};
+
+// Subscribers of one topic. A position index makes subscribe and unsubscribe
+// O(1): removal moves the last member into the hole, so the order of
+// members is unspecified.
+template<typename Member>
+class SubscriberList {
+    std::vector<Member*> members_;
+    std::unordered_map<const Member*, std::size_t> positions_;
+public:
+    // Returns false if member was already subscribed
+    bool add(Member* member) {
+        if (!positions_.emplace(member, members_.size()).second) {
+            return false;
+        }
+        members_.push_back(member);
+        return true;
+    }
+
+    // Returns false if member was not subscribed
+    bool remove(const Member* member) {
+        auto it = positions_.find(member);
+        if (it == positions_.end()) {
+            return false;
+        }
+        std::size_t position = it->second;
+        positions_.erase(it);
+        Member* last = members_.back();
+        members_.pop_back();
+        if (position < members_.size()) {
+            members_[position] = last;
+            positions_[last] = position;
+        }
+        return true;
+    }
+
+    bool empty() const { return members_.empty(); }
+    const std::vector<Member*>& getMembers() const { return members_; }
 };
 
 // Colleague interface
@@ -28,18 +99,42 @@ public:
     virtual ~Colleague() = default;
     virtual void send(const std::string& message) = 0;
     virtual void receive(const std::string& message) = 0;
+    // Shared-buffer delivery; override to keep the message without copying it
+    virtual void receive(const Message& message) { receive(message.getText()); }
+    // Batched delivery; override to handle a whole batch in one call
+    virtual void receiveBatch(std::span<const Message> messages) {
+        for (const auto& message : messages) {
+            receive(message);
+        }
+    }
     const std::string& getName() const { return name_; }
 };
 
+inline void Mediator::sendMessage(const std::string& message, Colleague* sender) {
+    sendMessage(Message(sender != nullptr ? sender->getName() : std::string(), message), sender);
+}
+
 // Concrete Colleague: User
 class User : public Colleague {
 public:
     User(Mediator* mediator, const std::string& name) 
         : Colleague(mediator, name) {}
     
+    using Colleague::receive;
+    
     void send(const std::string& message) override {
         std::cout << name_ << " sends: " << message << std::endl;
-        mediator_->sendMessage(message, this);
+        mediator_->sendMessage(Message(name_, message), this);
+    }
+    
+    void sendTo(const std::string& recipient, const std::string& message) {
+        std::cout << name_ << " sends to " << recipient << ": " << message << std::endl;
+        mediator_->sendMessageTo(recipient, Message(name_, message), this);
+    }
+    
+    void publish(const std::string& topic, const std::string& message) {
+        std::cout << name_ << " publishes on " << topic << ": " << message << std::endl;
+        mediator_->publishMessage(topic, Message(name_, message), this);
     }
     
     void receive(const std::string& message) override {
@@ -48,14 +143,59 @@ public:
 };
 
 // Concrete Mediator: ChatRoom
+// Besides broadcast, it routes by name and by topic through hash indexes, so
+// a directed or topic message only touches its own recipients.
 class ChatRoom : public Mediator {
+protected:
     std::vector<std::shared_ptr<Colleague>> users_;
+    std::unordered_map<std::string, Colleague*> usersByName_;
+    std::unordered_map<std::string, SubscriberList<Colleague>> subscribers_;
 public:
+    using Mediator::sendMessage;
+    
+    // Names are the routing key for sendMessageTo; a later user with the same
+    // name takes over directed messages
     void addUser(std::shared_ptr<Colleague> user) {
+        usersByName_[user->getName()] = user.get();
         users_.push_back(user);
     }
     
-    void sendMessage(const std::string& message, Colleague* sender) override {
+    // Colleagues must have been added to the room before subscribing
+    void subscribe(const std::string& topic, Colleague* colleague) {
+        subscribers_[topic].add(colleague);
+    }
+    
+    void unsubscribe(const std::string& topic, Colleague* colleague) {
+        auto it = subscribers_.find(topic);
+        if (it == subscribers_.end()) {
+            return;
+        }
+        it->second.remove(colleague);
+        if (it->second.empty()) {
+            subscribers_.erase(it);
+        }
+    }
+    
+    void sendMessageTo(const std::string& recipient, const Message& message, Colleague* sender) override {
+        auto it = usersByName_.find(recipient);
+        if (it != usersByName_.end() && it->second != sender) {
+            it->second->receive(message);
+        }
+    }
+    
+    void publishMessage(const std::string& topic, const Message& message, Colleague* sender) override {
+        auto it = subscribers_.find(topic);
+        if (it == subscribers_.end()) {
+            return;
+        }
+        for (Colleague* subscriber : it->second.getMembers()) {
+            if (subscriber != sender) {
+                subscriber->receive(message);
+            }
+        }
+    }
+    
+    void sendMessage(const Message& message, Colleague* sender) override {
         for (auto& user : users_) {
             if (user.get() != sender) {
                 user->receive(message);
@@ -65,5 +205,6 @@ public:
 };
 
 void demonstrateMediatorPattern();
+void benchmarkMediatorBroadcast();
 
 #endif // MEDIATOR_HPP 
\ No newline at end of file
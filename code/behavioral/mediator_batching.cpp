@@ -0,0 +1,240 @@
+#include "mediator_batching.hpp"
+#include <iostream>
+#include <thread>
+
+BatchingChatRoom::BatchingChatRoom(std::size_t maxMessages, std::chrono::steady_clock::duration maxDelay)
+    : maxMessages_(maxMessages), maxDelay_(maxDelay), batchesDelivered_(0), stopping_(false) {
+    timer_ = std::thread([this]() { timerLoop(); });
+}
+
+BatchingChatRoom::~BatchingChatRoom() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    windowCondition_.notify_one();
+    timer_.join();
+    flush();
+}
+
+void BatchingChatRoom::sendMessage(const Message& message, Colleague* sender) {
+    bool full = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.empty()) {
+            windowStart_ = std::chrono::steady_clock::now();
+            windowCondition_.notify_one();
+        }
+        pending_.push_back(Pending{message, sender});
+        sendersInWindow_.insert(sender);
+        full = pending_.size() >= maxMessages_;
+    }
+    if (full) {
+        flush();
+    }
+}
+
+void BatchingChatRoom::sendMessageTo(const std::string& recipient, const Message& message, Colleague* sender) {
+    std::lock_guard<std::recursive_mutex> delivery(deliveryMutex_);
+    flush();
+    ChatRoom::sendMessageTo(recipient, message, sender);
+}
+
+void BatchingChatRoom::publishMessage(const std::string& topic, const Message& message, Colleague* sender) {
+    std::lock_guard<std::recursive_mutex> delivery(deliveryMutex_);
+    flush();
+    ChatRoom::publishMessage(topic, message, sender);
+}
+
+void BatchingChatRoom::poll() {
+    bool expired = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        expired = !pending_.empty() && std::chrono::steady_clock::now() - windowStart_ >= maxDelay_;
+    }
+    if (expired) {
+        flush();
+    }
+}
+
+void BatchingChatRoom::timerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (pending_.empty()) {
+            windowCondition_.wait(lock);
+            continue;
+        }
+        auto deadline = windowStart_ + maxDelay_;
+        if (std::chrono::steady_clock::now() < deadline) {
+            // A flush or a new window may move the deadline; recheck on wakeup
+            windowCondition_.wait_until(lock, deadline);
+            continue;
+        }
+        lock.unlock();
+        poll();
+        lock.lock();
+    }
+}
+
+void BatchingChatRoom::flush() {
+    std::lock_guard<std::recursive_mutex> delivery(deliveryMutex_);
+
+    // Swap out first: a receiver that sends starts the next window
+    std::vector<Pending> pending;
+    std::unordered_set<Colleague*> senders;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.empty()) {
+            return;
+        }
+        pending.swap(pending_);
+        senders.swap(sendersInWindow_);
+        ++batchesDelivered_;
+    }
+
+    std::vector<Message> batch;
+    batch.reserve(pending.size());
+    for (const auto& entry : pending) {
+        batch.push_back(entry.message);
+    }
+
+    std::vector<Message> filtered;
+    for (auto& user : users_) {
+        if (senders.count(user.get()) == 0) {
+            user->receiveBatch(batch);
+            continue;
+        }
+        filtered.clear();
+        for (const auto& entry : pending) {
+            if (entry.sender != user.get()) {
+                filtered.push_back(entry.message);
+            }
+        }
+        if (!filtered.empty()) {
+            user->receiveBatch(filtered);
+        }
+    }
+}
+
+namespace {
+
+// Counts messages and the characters of their text; handles batches in one
+// call but still reads every message, like a per-message receive() would
+class BatchCountingUser : public Colleague {
+public:
+    std::size_t received = 0;
+    std::size_t characters = 0;
+
+    BatchCountingUser(Mediator* mediator, const std::string& name) : Colleague(mediator, name) {}
+    void send(const std::string& message) override { mediator_->sendMessage(message, this); }
+    void receive(const std::string& message) override {
+        ++received;
+        characters += message.size();
+    }
+    void receive(const Message& message) override { receive(message.getText()); }
+    void receiveBatch(std::span<const Message> messages) override {
+        for (const auto& message : messages) {
+            characters += message.getText().size();
+        }
+        received += messages.size();
+    }
+};
+
+// Same work per message, one message at a time, no batch hook
+class MessageCountingUser : public Colleague {
+public:
+    std::size_t received = 0;
+    std::size_t characters = 0;
+
+    MessageCountingUser(Mediator* mediator, const std::string& name) : Colleague(mediator, name) {}
+    void send(const std::string& message) override { mediator_->sendMessage(message, this); }
+    void receive(const std::string& message) override {
+        ++received;
+        characters += message.size();
+    }
+    void receive(const Message& message) override { receive(message.getText()); }
+};
+
+struct DeliveryCost {
+    double nanosPerDelivery;
+    std::size_t charactersRead;  // the same on every path, or the comparison is off
+};
+
+template<typename Room, typename UserType>
+DeliveryCost measureDelivery(Room& room, int users, int messages) {
+    std::vector<std::shared_ptr<UserType>> colleagues;
+    for (int i = 0; i < users; ++i) {
+        auto user = std::make_shared<UserType>(&room, "user" + std::to_string(i));
+        colleagues.push_back(user);
+        room.addUser(user);
+    }
+
+    const Message message("sender", "tick");
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < messages; ++i) {
+        room.sendMessage(message, nullptr);
+    }
+    if constexpr (requires { room.flush(); }) {
+        room.flush();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+
+    std::size_t characters = 0;
+    for (const auto& colleague : colleagues) {
+        characters += colleague->characters;
+    }
+    return DeliveryCost{elapsed.count() / (static_cast<double>(users) * messages), characters};
+}
+
+}
+
+void demonstrateBatchingMediator() {
+    std::cout << "\n=== Batching Mediator Demo ===\n" << std::endl;
+
+    BatchingChatRoom room(3, std::chrono::milliseconds(50));
+    auto alice = std::make_shared<User>(&room, "Alice");
+    auto bob = std::make_shared<User>(&room, "Bob");
+    auto counter = std::make_shared<BatchCountingUser>(&room, "Counter");
+    room.addUser(alice);
+    room.addUser(bob);
+    room.addUser(counter);
+
+    std::cout << "Three messages fill one batch:" << std::endl;
+    alice->send("one");
+    alice->send("two");
+    bob->send("three");
+
+    std::cout << "\nA lone message goes out when its window expires:" << std::endl;
+    alice->send("four");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // Waits for a delivery the timer may still be in the middle of
+    room.flush();
+
+    std::cout << "\nCounter received " << counter->received << " messages in "
+              << room.getBatchesDelivered() << " batches" << std::endl;
+
+    std::cout << "\n=== End Batching Mediator Demo ===\n" << std::endl;
+}
+
+void benchmarkBatchingMediator(int users, int messages) {
+    std::cout << "\n=== Batching Mediator Benchmark ===\n" << std::endl;
+
+    ChatRoom direct;
+    DeliveryCost perMessage = measureDelivery<ChatRoom, MessageCountingUser>(direct, users, messages);
+
+    BatchingChatRoom batching(64, std::chrono::milliseconds(1));
+    DeliveryCost batched = measureDelivery<BatchingChatRoom, BatchCountingUser>(batching, users, messages);
+
+    BatchingChatRoom fallback(64, std::chrono::milliseconds(1));
+    DeliveryCost fallbackCost = measureDelivery<BatchingChatRoom, MessageCountingUser>(fallback, users, messages);
+
+    std::cout << users << " recipients, " << messages << " messages; every path reads each message's text ("
+              << perMessage.charactersRead << ", " << batched.charactersRead << " and "
+              << fallbackCost.charactersRead << " characters)" << std::endl;
+    std::cout << "Per-message receive:     " << perMessage.nanosPerDelivery << " ns per delivery" << std::endl;
+    std::cout << "Batched receive (64):    " << batched.nanosPerDelivery << " ns per delivery ("
+              << perMessage.nanosPerDelivery / batched.nanosPerDelivery << "x less overhead)" << std::endl;
+    std::cout << "Batched, no batch hook:  " << fallbackCost.nanosPerDelivery << " ns per delivery" << std::endl;
+
+    std::cout << "\n=== End Batching Mediator Benchmark ===\n" << std::endl;
+}
@@ -0,0 +1,79 @@
+#ifndef MEDIATOR_BATCHING_HPP
+#define MEDIATOR_BATCHING_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "mediator.hpp"
+
+// Concrete Mediator: ChatRoom that coalesces broadcasts into batches.
+//
+// Broadcasts are held for a window (maxMessages messages or maxDelay,
+// whichever comes first) and then handed to each recipient with a single
+// receiveBatch() call. All recipients share one batch; only colleagues who
+// sent something during the window get their own copy with their messages
+// left out. Colleagues without a batch hook fall back to one receive() per
+// message through Colleague's default receiveBatch().
+//
+// The window is room-wide rather than per recipient: a broadcast reaches
+// every recipient at the same moment, so per-recipient windows would open
+// and expire together anyway, and one shared batch saves appending every
+// message to every recipient's queue.
+//
+// A timer thread delivers the batch as soon as its window expires, so a
+// quiet room does not hold messages back until the next send. Batches are
+// delivered one at a time, in order, from whichever thread completes them.
+// Directed and topic messages flush pending broadcasts first so recipients
+// still see messages in send order. Add users and subscribe before sending.
+class BatchingChatRoom : public ChatRoom {
+    struct Pending {
+        Message message;
+        Colleague* sender;
+    };
+
+    std::size_t maxMessages_;
+    std::chrono::steady_clock::duration maxDelay_;
+    // Held while delivering; recursive so receivers may send
+    std::recursive_mutex deliveryMutex_;
+    std::mutex mutex_;
+    std::condition_variable windowCondition_;
+    std::vector<Pending> pending_;
+    std::unordered_set<Colleague*> sendersInWindow_;
+    std::chrono::steady_clock::time_point windowStart_;
+    std::size_t batchesDelivered_;
+    bool stopping_;
+    std::thread timer_;
+
+public:
+    using ChatRoom::sendMessage;
+
+    explicit BatchingChatRoom(std::size_t maxMessages = 64,
+                              std::chrono::steady_clock::duration maxDelay = std::chrono::milliseconds(1));
+    ~BatchingChatRoom() override;
+
+    void sendMessage(const Message& message, Colleague* sender) override;
+    void sendMessageTo(const std::string& recipient, const Message& message, Colleague* sender) override;
+    void publishMessage(const std::string& topic, const Message& message, Colleague* sender) override;
+
+    // Delivers the pending batch if its window has expired
+    void poll();
+    // Delivers the pending batch now
+    void flush();
+
+    std::size_t getBatchesDelivered() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batchesDelivered_;
+    }
+
+private:
+    void timerLoop();
+};
+
+void demonstrateBatchingMediator();
+void benchmarkBatchingMediator(int users = 10'000, int messages = 1'000);
+
+#endif // MEDIATOR_BATCHING_HPP
@@ -0,0 +1,373 @@
+#include "mediator_mailbox.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+// Mailbox: one colleague's queue plus its delivery counters
+class AsyncChatRoom::Mailbox {
+public:
+    std::shared_ptr<Colleague> owner;
+    BoundedQueue<Message> queue;
+    std::atomic<bool> scheduled{false};
+    std::atomic<bool> disconnected{false};
+    std::atomic<std::size_t> maxDepth{0};
+    std::atomic<std::uint64_t> delivered{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<std::uint64_t> latencyTotalNanos{0};
+    std::atomic<std::uint64_t> latencyMaxNanos{0};
+
+    Mailbox(std::shared_ptr<Colleague> colleague, std::size_t capacity)
+        : owner(std::move(colleague)), queue(capacity) {}
+};
+
+namespace {
+
+// Whether the current thread is a delivery thread of some AsyncChatRoom
+thread_local bool onDeliveryThread = false;
+
+template<typename Counter>
+void updateMax(std::atomic<Counter>& target, Counter value) {
+    Counter current = target.load(std::memory_order_relaxed);
+    while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+}
+
+AsyncChatRoom::AsyncChatRoom(std::size_t deliveryThreads, std::size_t mailboxCapacity,
+                             BackpressurePolicy policy)
+    : policy_(policy), mailboxCapacity_(mailboxCapacity), pending_(0), stopping_(false), blockedSenders_(0) {
+    for (auto& bucket : latencyHistogram_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    for (std::size_t i = 0; i < std::max<std::size_t>(1, deliveryThreads); ++i) {
+        workers_.emplace_back([this]() { deliveryLoop(); });
+    }
+}
+
+AsyncChatRoom::~AsyncChatRoom() {
+    {
+        std::lock_guard<std::mutex> lock(readyMutex_);
+        stopping_ = true;
+    }
+    readyCondition_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void AsyncChatRoom::addUser(std::shared_ptr<Colleague> user) {
+    auto mailbox = std::make_shared<Mailbox>(std::move(user), mailboxCapacity_);
+    std::unique_lock<std::shared_mutex> lock(mailboxesMutex_);
+    mailboxesByName_[mailbox->owner->getName()] = mailbox.get();
+    mailboxesByColleague_[mailbox->owner.get()] = mailbox.get();
+    mailboxes_.push_back(std::move(mailbox));
+}
+
+void AsyncChatRoom::subscribe(const std::string& topic, Colleague* colleague) {
+    std::unique_lock<std::shared_mutex> lock(mailboxesMutex_);
+    auto it = mailboxesByColleague_.find(colleague);
+    if (it != mailboxesByColleague_.end()) {
+        subscribers_[topic].add(it->second);
+    }
+}
+
+void AsyncChatRoom::unsubscribe(const std::string& topic, Colleague* colleague) {
+    std::unique_lock<std::shared_mutex> lock(mailboxesMutex_);
+    auto topicIt = subscribers_.find(topic);
+    auto mailboxIt = mailboxesByColleague_.find(colleague);
+    if (topicIt == subscribers_.end() || mailboxIt == mailboxesByColleague_.end()) {
+        return;
+    }
+    topicIt->second.remove(mailboxIt->second);
+    if (topicIt->second.empty()) {
+        subscribers_.erase(topicIt);
+    }
+}
+
+void AsyncChatRoom::sendMessage(const Message& message, Colleague* sender) {
+    std::shared_lock<std::shared_mutex> lock(mailboxesMutex_);
+    for (auto& mailbox : mailboxes_) {
+        if (mailbox->owner.get() != sender) {
+            enqueue(*mailbox, message);
+        }
+    }
+}
+
+void AsyncChatRoom::sendMessageTo(const std::string& recipient, const Message& message, Colleague* sender) {
+    std::shared_lock<std::shared_mutex> lock(mailboxesMutex_);
+    auto it = mailboxesByName_.find(recipient);
+    if (it != mailboxesByName_.end() && it->second->owner.get() != sender) {
+        enqueue(*it->second, message);
+    }
+}
+
+void AsyncChatRoom::publishMessage(const std::string& topic, const Message& message, Colleague* sender) {
+    std::shared_lock<std::shared_mutex> lock(mailboxesMutex_);
+    auto it = subscribers_.find(topic);
+    if (it == subscribers_.end()) {
+        return;
+    }
+    for (Mailbox* mailbox : it->second.getMembers()) {
+        if (mailbox->owner.get() != sender) {
+            enqueue(*mailbox, message);
+        }
+    }
+}
+
+void AsyncChatRoom::enqueue(Mailbox& mailbox, const Message& message) {
+    if (mailbox.disconnected.load(std::memory_order_relaxed)) {
+        mailbox.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    while (!mailbox.queue.tryPush(message)) {
+        switch (policy_) {
+            case BackpressurePolicy::Block:
+                if (onDeliveryThread) {
+                    // The mailbox may only drain on this very thread
+                    completed(1);
+                    throw std::runtime_error("AsyncChatRoom: mailbox full when sending from receive()");
+                }
+                waitForSpace(mailbox);
+                break;
+            case BackpressurePolicy::DropOldest:
+                if (mailbox.queue.tryPop()) {
+                    mailbox.dropped.fetch_add(1, std::memory_order_relaxed);
+                    completed(1);
+                }
+                break;
+            case BackpressurePolicy::Disconnect:
+                mailbox.disconnected.store(true, std::memory_order_relaxed);
+                mailbox.dropped.fetch_add(1, std::memory_order_relaxed);
+                completed(1);
+                return;
+        }
+    }
+
+    updateMax(mailbox.maxDepth, mailbox.queue.sizeApprox());
+    schedule(mailbox);
+}
+
+void AsyncChatRoom::waitForSpace(Mailbox& mailbox) {
+    blockedSenders_.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the fence in deliveryLoop: either this sees the pop or the
+    // delivery thread sees this sender and wakes it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    {
+        std::unique_lock<std::mutex> lock(spaceMutex_);
+        spaceCondition_.wait(lock, [&mailbox]() {
+            return mailbox.queue.sizeApprox() < mailbox.queue.capacity();
+        });
+    }
+    blockedSenders_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void AsyncChatRoom::notifySpace() {
+    {
+        // Taking the lock orders this wakeup after a waiter's last check
+        std::lock_guard<std::mutex> lock(spaceMutex_);
+    }
+    spaceCondition_.notify_all();
+}
+
+void AsyncChatRoom::schedule(Mailbox& mailbox) {
+    // Pairs with the fence in deliveryLoop so a push is never left unscheduled
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!mailbox.scheduled.exchange(true)) {
+        {
+            std::lock_guard<std::mutex> lock(readyMutex_);
+            ready_.push_back(&mailbox);
+        }
+        readyCondition_.notify_one();
+    }
+}
+
+void AsyncChatRoom::deliveryLoop() {
+    constexpr std::size_t kBatch = 64;
+    onDeliveryThread = true;
+
+    for (;;) {
+        Mailbox* mailbox = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(readyMutex_);
+            readyCondition_.wait(lock, [this]() { return stopping_ || !ready_.empty(); });
+            if (ready_.empty()) {
+                return;
+            }
+            mailbox = ready_.front();
+            ready_.pop_front();
+        }
+
+        // Drain a bounded batch so one busy mailbox cannot starve the others
+        std::uint64_t count = 0;
+        while (count < kBatch) {
+            auto message = mailbox->queue.tryPop();
+            if (!message) {
+                break;
+            }
+            if (blockedSenders_.load(std::memory_order_relaxed) > 0) {
+                notifySpace();
+            }
+            mailbox->owner->receive(*message);
+
+            auto latency = std::chrono::steady_clock::now() - message->getSentAt();
+            auto nanos = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+            mailbox->latencyTotalNanos.fetch_add(nanos, std::memory_order_relaxed);
+            updateMax(mailbox->latencyMaxNanos, nanos);
+            recordLatency(nanos);
+            ++count;
+        }
+        mailbox->delivered.fetch_add(count, std::memory_order_relaxed);
+
+        mailbox->scheduled.store(false);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (mailbox->queue.sizeApprox() > 0 && !mailbox->scheduled.exchange(true)) {
+            std::lock_guard<std::mutex> lock(readyMutex_);
+            ready_.push_back(mailbox);
+        }
+        // The check after each pop may have missed a sender that just arrived
+        if (blockedSenders_.load(std::memory_order_relaxed) > 0) {
+            notifySpace();
+        }
+
+        if (count > 0) {
+            completed(count);
+        }
+    }
+}
+
+void AsyncChatRoom::recordLatency(std::uint64_t nanos) {
+    std::size_t bucket = std::min<std::size_t>(std::bit_width(nanos), kLatencyBuckets - 1);
+    latencyHistogram_[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void AsyncChatRoom::completed(std::uint64_t count) {
+    if (pending_.fetch_sub(count, std::memory_order_acq_rel) == count) {
+        std::lock_guard<std::mutex> lock(readyMutex_);
+        idleCondition_.notify_all();
+    }
+}
+
+void AsyncChatRoom::flush() {
+    std::unique_lock<std::mutex> lock(readyMutex_);
+    idleCondition_.wait(lock, [this]() { return pending_.load(std::memory_order_acquire) == 0; });
+}
+
+std::vector<MailboxMetrics> AsyncChatRoom::getMetrics() const {
+    std::vector<MailboxMetrics> metrics;
+    std::shared_lock<std::shared_mutex> lock(mailboxesMutex_);
+    for (const auto& mailbox : mailboxes_) {
+        MailboxMetrics entry;
+        entry.colleague = mailbox->owner->getName();
+        entry.depth = mailbox->queue.sizeApprox();
+        entry.maxDepth = mailbox->maxDepth.load(std::memory_order_relaxed);
+        entry.delivered = mailbox->delivered.load(std::memory_order_relaxed);
+        entry.dropped = mailbox->dropped.load(std::memory_order_relaxed);
+        entry.disconnected = mailbox->disconnected.load(std::memory_order_relaxed);
+        if (entry.delivered > 0) {
+            entry.avgLatencyMicros =
+                static_cast<double>(mailbox->latencyTotalNanos.load(std::memory_order_relaxed)) /
+                static_cast<double>(entry.delivered) / 1000.0;
+        }
+        entry.maxLatencyMicros =
+            static_cast<double>(mailbox->latencyMaxNanos.load(std::memory_order_relaxed)) / 1000.0;
+        metrics.push_back(entry);
+    }
+    return metrics;
+}
+
+double AsyncChatRoom::getLatencyPercentileMicros(double percentile) const {
+    std::uint64_t total = 0;
+    for (const auto& bucket : latencyHistogram_) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0.0;
+    }
+
+    auto target = static_cast<std::uint64_t>(static_cast<double>(total) * percentile / 100.0);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kLatencyBuckets; ++i) {
+        seen += latencyHistogram_[i].load(std::memory_order_relaxed);
+        if (seen > target || i == kLatencyBuckets - 1) {
+            // Upper bound of the power-of-two bucket
+            return static_cast<double>(std::uint64_t(1) << i) / 1000.0;
+        }
+    }
+    return 0.0;
+}
+
+namespace {
+
+// Colleague whose receive() takes a while, e.g. a remote client
+class SlowUser : public User {
+    std::chrono::milliseconds delay_;
+public:
+    SlowUser(Mediator* mediator, const std::string& name, std::chrono::milliseconds delay)
+        : User(mediator, name), delay_(delay) {}
+
+    using User::receive;
+
+    void receive(const std::string& message) override {
+        std::this_thread::sleep_for(delay_);
+        User::receive(message);
+    }
+};
+
+void printMetrics(const AsyncChatRoom& room) {
+    for (const auto& entry : room.getMetrics()) {
+        std::cout << "  " << entry.colleague << ": delivered " << entry.delivered
+                  << ", dropped " << entry.dropped << ", max depth " << entry.maxDepth
+                  << ", avg latency " << entry.avgLatencyMicros << " us"
+                  << (entry.disconnected ? " (disconnected)" : "") << std::endl;
+    }
+}
+
+}
+
+void demonstrateAsyncMediator() {
+    std::cout << "\n=== Async Mediator Demo ===\n" << std::endl;
+
+    {
+        AsyncChatRoom room(2, 16);
+        auto alice = std::make_shared<User>(&room, "Alice");
+        auto bob = std::make_shared<SlowUser>(&room, "Bob", std::chrono::milliseconds(20));
+        auto charlie = std::make_shared<User>(&room, "Charlie");
+        room.addUser(alice);
+        room.addUser(bob);
+        room.addUser(charlie);
+
+        auto start = std::chrono::steady_clock::now();
+        alice->send("Hello everyone!");
+        charlie->send("Hi Alice!");
+        auto sendTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        room.flush();
+        std::cout << "\nSending took " << sendTime.count()
+                  << " ms even though Bob needs 20 ms per message" << std::endl;
+        printMetrics(room);
+    }
+
+    std::cout << "\nDrop-oldest backpressure with a 4-slot mailbox:" << std::endl;
+    {
+        AsyncChatRoom room(1, 4, BackpressurePolicy::DropOldest);
+        auto sender = std::make_shared<SlowUser>(&room, "Sender", std::chrono::milliseconds(0));
+        auto slow = std::make_shared<SlowUser>(&room, "SlowReader", std::chrono::milliseconds(5));
+        room.addUser(sender);
+        room.addUser(slow);
+
+        for (int i = 0; i < 20; ++i) {
+            room.sendMessage("tick " + std::to_string(i), sender.get());
+        }
+        room.flush();
+        printMetrics(room);
+        std::cout << "  p99 latency: " << room.getLatencyPercentileMicros(99.0) << " us" << std::endl;
+    }
+
+    std::cout << "\n=== End Async Mediator Demo ===\n" << std::endl;
+}
@@ -0,0 +1,197 @@
+#ifndef MEDIATOR_MAILBOX_HPP
+#define MEDIATOR_MAILBOX_HPP
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "mediator.hpp"
+
+// Bounded lock-free queue (multi-producer, multi-consumer).
+// Each cell carries a sequence number that tells producers and consumers
+// whether it is free or full for their turn, so no locks are needed.
+template<typename T>
+class BoundedQueue {
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        std::optional<T> value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> enqueuePos_;
+    alignas(64) std::atomic<std::size_t> dequeuePos_;
+
+public:
+    // Capacity is rounded up to a power of two
+    explicit BoundedQueue(std::size_t capacity) : enqueuePos_(0), dequeuePos_(0) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        cells_.reset(new Cell[size]);
+        mask_ = size - 1;
+        for (std::size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(const T& value) {
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::optional<T> tryPop() {
+        std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    std::optional<T> value = std::move(cell.value);
+                    cell.value.reset();
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return value;
+                }
+            } else if (diff < 0) {
+                return std::nullopt;
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::size_t sizeApprox() const {
+        std::size_t enqueued = enqueuePos_.load(std::memory_order_relaxed);
+        std::size_t dequeued = dequeuePos_.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+};
+
+// What a sender does when a recipient's mailbox is full. Under Block, a
+// colleague that sends from inside receive() gets std::runtime_error instead
+// of waiting, because its delivery thread may be the one the full mailbox is
+// waiting for; recipients earlier in a broadcast keep the message.
+enum class BackpressurePolicy {
+    Block,       // wait until the recipient catches up
+    DropOldest,  // discard the oldest queued message to make room
+    Disconnect   // stop delivering to the slow recipient altogether
+};
+
+// Snapshot of one mailbox's counters
+struct MailboxMetrics {
+    std::string colleague;
+    std::size_t depth = 0;
+    std::size_t maxDepth = 0;
+    std::uint64_t delivered = 0;
+    std::uint64_t dropped = 0;
+    bool disconnected = false;
+    double avgLatencyMicros = 0.0;
+    double maxLatencyMicros = 0.0;
+};
+
+// Concrete Mediator: ChatRoom that delivers through per-colleague mailboxes.
+//
+// sendMessage only enqueues the shared Message into each recipient's mailbox;
+// a pool of delivery threads calls receive(). A mailbox is scheduled on at
+// most one delivery thread at a time and is FIFO, so every recipient sees a
+// given sender's messages in the order they were sent. Directed and topic
+// messages are queued in the same mailboxes, so that order holds across all
+// three kinds of send.
+class AsyncChatRoom : public Mediator {
+    class Mailbox;
+
+    // All guarded by mailboxesMutex_
+    std::vector<std::shared_ptr<Mailbox>> mailboxes_;
+    std::unordered_map<std::string, Mailbox*> mailboxesByName_;
+    std::unordered_map<const Colleague*, Mailbox*> mailboxesByColleague_;
+    std::unordered_map<std::string, SubscriberList<Mailbox>> subscribers_;
+    mutable std::shared_mutex mailboxesMutex_;
+
+    BackpressurePolicy policy_;
+    std::size_t mailboxCapacity_;
+
+    std::deque<Mailbox*> ready_;
+    std::mutex readyMutex_;
+    std::condition_variable readyCondition_;
+    std::condition_variable idleCondition_;
+    std::atomic<std::uint64_t> pending_;
+    bool stopping_;
+    std::vector<std::thread> workers_;
+
+    // Senders waiting on a full mailbox under Block
+    std::atomic<std::size_t> blockedSenders_;
+    std::mutex spaceMutex_;
+    std::condition_variable spaceCondition_;
+
+    static constexpr std::size_t kLatencyBuckets = 40;
+    std::array<std::atomic<std::uint64_t>, kLatencyBuckets> latencyHistogram_;
+
+public:
+    using Mediator::sendMessage;
+
+    AsyncChatRoom(std::size_t deliveryThreads, std::size_t mailboxCapacity,
+                  BackpressurePolicy policy = BackpressurePolicy::Block);
+    ~AsyncChatRoom() override;
+
+    AsyncChatRoom(const AsyncChatRoom&) = delete;
+    AsyncChatRoom& operator=(const AsyncChatRoom&) = delete;
+
+    // A later user with the same name takes over directed messages
+    void addUser(std::shared_ptr<Colleague> user);
+    // Colleagues must have been added to the room before subscribing
+    void subscribe(const std::string& topic, Colleague* colleague);
+    void unsubscribe(const std::string& topic, Colleague* colleague);
+
+    void sendMessage(const Message& message, Colleague* sender) override;
+    void sendMessageTo(const std::string& recipient, const Message& message, Colleague* sender) override;
+    void publishMessage(const std::string& topic, const Message& message, Colleague* sender) override;
+
+    // Blocks until every queued message has been delivered or dropped
+    void flush();
+
+    std::vector<MailboxMetrics> getMetrics() const;
+    // End-to-end latency percentile (0-100) over all deliveries, in microseconds
+    double getLatencyPercentileMicros(double percentile) const;
+
+private:
+    void enqueue(Mailbox& mailbox, const Message& message);
+    void waitForSpace(Mailbox& mailbox);
+    void notifySpace();
+    void schedule(Mailbox& mailbox);
+    void deliveryLoop();
+    void recordLatency(std::uint64_t nanos);
+    void completed(std::uint64_t count);
+};
+
+void demonstrateAsyncMediator();
+
+#endif // MEDIATOR_MAILBOX_HPP
@@ -1,6 +1,178 @@
 #include "memento.hpp"
+#include <bit>
+#include <chrono>
 #include <iostream>
 
+std::size_t Caretaker::position(int index) const {
+    if (evictedCount_ == 0) {
+        return static_cast<std::size_t>(index);
+    }
+    // Descend to the longest prefix holding at most index live entries; the
+    // entry right after it is the one we want
+    std::size_t node = 0;
+    std::size_t remaining = static_cast<std::size_t>(index);
+    for (std::size_t step = std::bit_floor(liveTree_.size() - 1); step > 0; step >>= 1) {
+        if (node + step < liveTree_.size() && liveTree_[node + step] <= remaining) {
+            node += step;
+            remaining -= liveTree_[node];
+        }
+    }
+    return node - popped_;
+}
+
+void Caretaker::pushLive() {
+    // Node i covers (i - lowbit(i), i]: the new entry plus the nodes below it
+    std::size_t node = liveTree_.size();
+    std::uint32_t live = 1;
+    for (std::size_t child = node - 1; child > node - (node & -node); child -= child & -child) {
+        live += liveTree_[child];
+    }
+    liveTree_.push_back(live);
+}
+
+void Caretaker::rebuildLiveTree() {
+    liveTree_.assign(mementos_.size() + 1, 0);
+    for (std::size_t node = 1; node < liveTree_.size(); ++node) {
+        liveTree_[node] += mementos_[node - 1].evicted ? 0 : 1;
+        if (std::size_t parent = node + (node & -node); parent < liveTree_.size()) {
+            liveTree_[parent] += liveTree_[node];
+        }
+    }
+    popped_ = 0;
+}
+
+void Caretaker::applyRetention(Clock::time_point now) {
+    std::size_t steps = policy_.stepsPerAdd > 0 ? policy_.stepsPerAdd : 1;
+
+    while (steps > 0 && policy_.maxCount > 0 && static_cast<std::size_t>(getMementoCount()) > policy_.maxCount) {
+        if (!evictOldestUnpinned()) {
+            break;
+        }
+        --steps;
+    }
+    while (steps > 0 && policy_.maxDocumentBytes > 0 && documentBytes_ > policy_.maxDocumentBytes) {
+        if (!evictOldestUnpinned()) {
+            break;
+        }
+        --steps;
+    }
+
+    if (policy_.thinning.empty()) {
+        return;
+    }
+
+    // Sweep a few entries per call, wrapping around; the newest is never thinned
+    for (; steps > 0; --steps) {
+        if (thinCursor_ + 1 >= mementos_.size()) {
+            thinCursor_ = 0;
+            thinPrevious_ = kNone;
+            return;
+        }
+        const Entry& current = mementos_[thinCursor_];
+        if (current.evicted) {
+            ++thinCursor_;
+            continue;
+        }
+        bool sameBucket = false;
+        if (thinPrevious_ != kNone && !current.pinned) {
+            const Entry& previous = mementos_[thinPrevious_];
+            const ThinningTier* tier = tierFor(now - current.createdAt);
+            sameBucket = tier != nullptr && tierFor(now - previous.createdAt) == tier &&
+                previous.createdAt.time_since_epoch() / tier->keepOnePer ==
+                    current.createdAt.time_since_epoch() / tier->keepOnePer;
+        }
+        // Advance first: evicting may pop or compact, which moves the cursors
+        std::size_t position = thinCursor_++;
+        if (sameBucket) {
+            evict(position);
+        } else {
+            thinPrevious_ = position;
+        }
+    }
+}
+
+bool Caretaker::evictOldestUnpinned() {
+    // The newest memento always stays
+    for (; evictCursor_ + 1 < mementos_.size(); ++evictCursor_) {
+        const Entry& entry = mementos_[evictCursor_];
+        if (!entry.evicted && !entry.pinned) {
+            evict(evictCursor_);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Caretaker::evict(std::size_t position) {
+    Entry& entry = mementos_[position];
+    entry.evicted = true;
+    entry.memento.reset();
+    documentBytes_ -= entry.bytes;
+    ++evictedCount_;
+    if (thinPrevious_ == position) {
+        thinPrevious_ = kNone;
+    }
+    for (std::size_t node = position + popped_ + 1; node < liveTree_.size(); node += node & -node) {
+        --liveTree_[node];
+    }
+
+    while (!mementos_.empty() && mementos_.front().evicted) {
+        mementos_.pop_front();
+        ++popped_;
+        --evictedCount_;
+        evictCursor_ -= evictCursor_ > 0;
+        thinCursor_ -= thinCursor_ > 0;
+        thinPrevious_ = thinPrevious_ == 0 || thinPrevious_ == kNone ? kNone : thinPrevious_ - 1;
+    }
+    // Paid for by the evictions since the last compaction
+    if (evictedCount_ * 2 > mementos_.size()) {
+        compact();
+    } else if (popped_ > mementos_.size()) {
+        rebuildLiveTree();
+    }
+}
+
+void Caretaker::compact() {
+    std::size_t kept = 0;
+    std::size_t evictCursor = 0;
+    std::size_t thinCursor = 0;
+    std::size_t thinPrevious = kNone;
+    for (std::size_t i = 0; i < mementos_.size(); ++i) {
+        // Cursors move to the first live entry at or after their old position
+        if (i < evictCursor_) {
+            evictCursor = kept + (mementos_[i].evicted ? 0 : 1);
+        }
+        if (i < thinCursor_) {
+            thinCursor = kept + (mementos_[i].evicted ? 0 : 1);
+        }
+        if (i == thinPrevious_) {
+            thinPrevious = kept;
+        }
+        if (!mementos_[i].evicted) {
+            if (kept != i) {
+                mementos_[kept] = std::move(mementos_[i]);
+            }
+            ++kept;
+        }
+    }
+    mementos_.resize(kept);
+    evictedCount_ = 0;
+    evictCursor_ = evictCursor;
+    thinCursor_ = thinCursor;
+    thinPrevious_ = thinPrevious;
+    rebuildLiveTree();
+}
+
+const ThinningTier* Caretaker::tierFor(Clock::duration age) const {
+    const ThinningTier* match = nullptr;
+    for (const auto& tier : policy_.thinning) {
+        if (age >= tier.olderThan) {
+            match = &tier;
+        }
+    }
+    return match;
+}
+
 void demonstrateMementoPattern() {
     std::cout << "\n=== Memento Pattern Demo ===\n" << std::endl;
 
@@ -33,4 +205,95 @@ void demonstrateMementoPattern() {
     editor.showContent();
 
     std::cout << "\n=== End Memento Pattern Demo ===\n" << std::endl;
-} 
\ No newline at end of file
+} 
+
+void demonstrateMementoRetention() {
+    std::cout << "\n=== Memento Retention Demo ===\n" << std::endl;
+
+    // Three hours of history, one snapshot every 10 seconds
+    Caretaker caretaker(MementoRetentionPolicy::exponential());
+    TextEditor editor;
+    editor.setContent("Draft");
+    auto start = Caretaker::Clock::now();
+    auto end = start + std::chrono::hours(3);
+    int added = 0;
+    for (auto time = start; time <= end; time += std::chrono::seconds(10)) {
+        editor.insertText(editor.getLength(), ".");
+        caretaker.addMemento(editor.createMemento(), time);
+        if (added == 42) {
+            caretaker.setPinned(caretaker.getMementoCount() - 1, true);
+        }
+        ++added;
+    }
+
+    int lastMinute = 0, lastHour = 0, older = 0, pinned = 0;
+    for (int i = 0; i < caretaker.getMementoCount(); ++i) {
+        auto age = end - caretaker.getCreatedAt(i);
+        if (caretaker.isPinned(i)) {
+            ++pinned;
+        } else if (age < std::chrono::minutes(1)) {
+            ++lastMinute;
+        } else if (age < std::chrono::hours(1)) {
+            ++lastHour;
+        } else {
+            ++older;
+        }
+    }
+
+    std::cout << "Added " << added << " snapshots over three hours" << std::endl;
+    std::cout << "Kept " << caretaker.getMementoCount() << ": " << lastMinute
+              << " from the last minute, " << lastHour << " from the last hour, " << older
+              << " older, " << pinned << " pinned" << std::endl;
+
+    // Count and size caps
+    MementoRetentionPolicy capped;
+    capped.maxCount = 5;
+    Caretaker small(capped);
+    for (int i = 0; i < 20; ++i) {
+        editor.setContent("Version " + std::to_string(i));
+        small.addMemento(editor.createMemento());
+    }
+    std::cout << "\nWith a cap of 5, the oldest kept snapshot is: "
+              << small.getMemento(0)->getState() << std::endl;
+
+    std::cout << "\n=== End Memento Retention Demo ===\n" << std::endl;
+}
+
+void benchmarkTextEditorSnapshots(std::size_t megabytes, int keystrokes) {
+    std::cout << "\n=== Text Editor Snapshot Benchmark ===\n" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    TextEditor editor;
+    Caretaker caretaker;
+
+    auto loadStart = Clock::now();
+    editor.setContent(std::string(megabytes << 20, 'a'));
+    double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - loadStart).count();
+
+    // Type one character at a time at scattered positions, snapshot after each
+    std::size_t position = 0;
+    auto editStart = Clock::now();
+    for (int i = 0; i < keystrokes; ++i) {
+        position = (position + 7'919'993) % (editor.getLength() + 1);
+        if (i % 4 == 3) {
+            editor.eraseText(position, 1);
+        } else {
+            editor.insertText(position, std::string(1, static_cast<char>('b' + i % 20)));
+        }
+        caretaker.addMemento(editor.createMemento());
+    }
+    double editSeconds = std::chrono::duration<double>(Clock::now() - editStart).count();
+
+    auto restoreStart = Clock::now();
+    editor.restoreFromMemento(caretaker.getMemento(0));
+    double restoreUs = std::chrono::duration<double, std::micro>(Clock::now() - restoreStart).count();
+
+    std::cout << "Document: " << megabytes << " MB, loaded in " << loadMs << " ms" << std::endl;
+    std::cout << "Keystrokes with a snapshot after each: " << keystrokes << " in "
+              << editSeconds * 1000.0 << " ms ("
+              << editSeconds * 1e6 / keystrokes << " us per keystroke + snapshot)" << std::endl;
+    std::cout << "Snapshots held: " << caretaker.getMementoCount()
+              << ", restore of the oldest: " << restoreUs << " us" << std::endl;
+
+    std::cout << "\n=== End Text Editor Snapshot Benchmark ===\n" << std::endl;
+}
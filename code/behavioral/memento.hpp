@@ -1,29 +1,53 @@
 #ifndef MEMENTO_HPP
 #define MEMENTO_HPP
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <memory>
+#include "rope.hpp"
 
 // Memento class - stores the state
+// The state is a persistent rope, so a memento shares its text with the
+// editor and with every other memento instead of copying it.
 class Memento {
-    std::string state_;
+    Rope state_;
 public:
     explicit Memento(const std::string& state) : state_(state) {}
-    std::string getState() const { return state_; }
+    explicit Memento(Rope state) : state_(std::move(state)) {}
+    std::string getState() const { return state_.toString(); }
+    const Rope& getRope() const { return state_; }
 };
 
 // Originator class - creates and uses mementos
+// Edits are O(log n) and produce a new rope version; taking a memento just
+// retains the current root, so it is O(1) whatever the document size.
 class TextEditor {
-    std::string content_;
+    Rope content_;
 public:
     void setContent(const std::string& content) {
-        content_ = content;
+        content_ = Rope(content);
     }
     
     std::string getContent() const {
-        return content_;
+        return content_.toString();
+    }
+    
+    std::size_t getLength() const {
+        return content_.length();
+    }
+    
+    void insertText(std::size_t position, const std::string& text) {
+        content_ = content_.insert(position, text);
+    }
+    
+    void eraseText(std::size_t position, std::size_t count) {
+        content_ = content_.erase(position, count);
     }
     
     // Creates a memento
@@ -33,34 +57,149 @@ public:
     
     // Restores state from memento
     void restoreFromMemento(const std::shared_ptr<Memento>& memento) {
-        content_ = memento->getState();
+        content_ = memento->getRope();
     }
     
     void showContent() const {
-        std::cout << "Current content: " << content_ << std::endl;
+        std::cout << "Current content: " << content_.toString() << std::endl;
+    }
+};
+
+// Thinning rule: snapshots older than olderThan are kept at most one per
+// keepOnePer interval (the oldest snapshot in each interval survives)
+struct ThinningTier {
+    std::chrono::seconds olderThan;
+    std::chrono::seconds keepOnePer;
+};
+
+// Which mementos a Caretaker keeps. The default keeps everything.
+struct MementoRetentionPolicy {
+    std::size_t maxCount = 0;            // 0 = unbounded
+    // 0 = unbounded. Sums document lengths, not memory: mementos share rope
+    // leaves, so the memory they retain is usually far smaller.
+    std::size_t maxDocumentBytes = 0;
+    std::vector<ThinningTier> thinning;  // sorted by olderThan
+    std::size_t stepsPerAdd = 8;         // eviction work done per addMemento
+
+    // Everything from the last minute, one per minute for the last hour,
+    // one per hour beyond that
+    static MementoRetentionPolicy exponential() {
+        MementoRetentionPolicy policy;
+        policy.thinning = {{std::chrono::minutes(1), std::chrono::minutes(1)},
+                           {std::chrono::hours(1), std::chrono::hours(1)}};
+        return policy;
     }
 };
 
 // Caretaker class - manages mementos
+// An optional retention policy caps the history by count and size, thins it
+// out with age, and never evicts pinned mementos. Eviction is incremental:
+// each addMemento does at most stepsPerAdd steps of it, so a large backlog
+// is worked off over the next few adds instead of in one long pause.
+//
+// A step is O(1) amortized. An evicted entry is only marked; marked entries
+// are popped once they reach the front and compacted away once they
+// outnumber the live ones. In between, a Fenwick tree over the live entries
+// finds the index-th one in O(log n), so access by index never compacts.
 class Caretaker {
-    std::vector<std::shared_ptr<Memento>> mementos_;
 public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    static constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+    struct Entry {
+        std::shared_ptr<Memento> memento;
+        Clock::time_point createdAt;
+        std::size_t bytes;
+        bool pinned;
+        bool evicted;
+    };
+
+    std::deque<Entry> mementos_;
+    std::size_t evictedCount_ = 0;
+    // Nothing before evictCursor_ is both live and unpinned
+    std::size_t evictCursor_ = 0;
+    std::size_t thinCursor_ = 0;
+    // Last live entry the thinning sweep kept
+    std::size_t thinPrevious_ = kNone;
+    // 1-based Fenwick tree holding 1 per live entry, over the positions since
+    // it was last rebuilt; the popped_ entries popped since then keep their
+    // (zero) nodes at the start
+    std::vector<std::uint32_t> liveTree_{0};
+    std::size_t popped_ = 0;
+    MementoRetentionPolicy policy_;
+    std::size_t documentBytes_ = 0;
+
+public:
+    Caretaker() = default;
+    explicit Caretaker(MementoRetentionPolicy policy) : policy_(std::move(policy)) {}
+    
     void addMemento(const std::shared_ptr<Memento>& memento) {
-        mementos_.push_back(memento);
+        addMemento(memento, Clock::now());
+    }
+    
+    // Records the memento as taken at createdAt, e.g. when importing history
+    void addMemento(const std::shared_ptr<Memento>& memento, Clock::time_point createdAt) {
+        std::size_t bytes = memento->getRope().length();
+        mementos_.push_back(Entry{memento, createdAt, bytes, false, false});
+        pushLive();
+        documentBytes_ += bytes;
+        applyRetention(createdAt);
     }
     
     std::shared_ptr<Memento> getMemento(int index) {
-        if (index >= 0 && index < static_cast<int>(mementos_.size())) {
-            return mementos_[index];
+        if (index >= 0 && index < getMementoCount()) {
+            return mementos_[position(index)].memento;
         }
         return nullptr;
     }
     
     int getMementoCount() const {
-        return static_cast<int>(mementos_.size());
+        return static_cast<int>(mementos_.size() - evictedCount_);
     }
+    
+    // Pinned mementos are exempt from every retention rule
+    void setPinned(int index, bool pinned) {
+        if (index >= 0 && index < getMementoCount()) {
+            std::size_t where = position(index);
+            mementos_[where].pinned = pinned;
+            if (!pinned) {
+                evictCursor_ = std::min(evictCursor_, where);
+            }
+        }
+    }
+    
+    bool isPinned(int index) const {
+        return index >= 0 && index < getMementoCount() && mementos_[position(index)].pinned;
+    }
+    
+    Clock::time_point getCreatedAt(int index) const {
+        if (index < 0 || index >= getMementoCount()) {
+            throw std::out_of_range("Caretaker::getCreatedAt");
+        }
+        return mementos_[position(index)].createdAt;
+    }
+    
+    // Sum of the document lengths of the kept mementos
+    std::size_t getTotalDocumentBytes() const {
+        return documentBytes_;
+    }
+
+private:
+    // Position in mementos_ of the index-th live entry
+    std::size_t position(int index) const;
+    void pushLive();
+    void rebuildLiveTree();
+    void applyRetention(Clock::time_point now);
+    bool evictOldestUnpinned();
+    void evict(std::size_t position);
+    void compact();
+    const ThinningTier* tierFor(Clock::duration age) const;
 };
 
 void demonstrateMementoPattern();
+void demonstrateMementoRetention();
+void benchmarkTextEditorSnapshots(std::size_t megabytes = 100, int keystrokes = 100'000);
 
 #endif // MEMENTO_HPP 
\ No newline at end of file
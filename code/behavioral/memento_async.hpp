@@ -0,0 +1,76 @@
+#ifndef MEMENTO_ASYNC_HPP
+#define MEMENTO_ASYNC_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "memento.hpp"
+
+// Handle to a snapshot whose serialization may still be running.
+// The memento itself is available immediately; the flattened text (and
+// whatever the sink did with it) completes later on the snapshotter thread.
+class SnapshotHandle {
+    std::shared_ptr<Memento> memento_;
+    std::shared_future<std::shared_ptr<const std::string>> serialized_;
+public:
+    SnapshotHandle(std::shared_ptr<Memento> memento,
+                   std::shared_future<std::shared_ptr<const std::string>> serialized)
+        : memento_(std::move(memento)), serialized_(std::move(serialized)) {}
+
+    const std::shared_ptr<Memento>& getMemento() const { return memento_; }
+
+    bool isReady() const {
+        return serialized_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    void wait() const { serialized_.wait(); }
+
+    // Blocks until serialization is done
+    const std::string& getSerialized() const { return *serialized_.get(); }
+};
+
+// Async Snapshotter: takes mementos without blocking the editing thread.
+//
+// snapshot() only retains the editor's current rope root, which is O(1) and
+// unaffected by later edits. Flattening it to a string, and handing that to
+// the optional sink (for example to write it to disk), happens on a
+// background thread in request order.
+class AsyncSnapshotter {
+public:
+    using Sink = std::function<void(const std::string& serialized)>;
+
+private:
+    struct Job {
+        std::shared_ptr<Memento> memento;
+        std::promise<std::shared_ptr<const std::string>> promise;
+    };
+
+    Sink sink_;
+    std::deque<Job> jobs_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_;
+    std::thread worker_;
+
+public:
+    explicit AsyncSnapshotter(Sink sink = Sink());
+    ~AsyncSnapshotter();
+
+    AsyncSnapshotter(const AsyncSnapshotter&) = delete;
+    AsyncSnapshotter& operator=(const AsyncSnapshotter&) = delete;
+
+    SnapshotHandle snapshot(TextEditor& editor);
+
+private:
+    void run();
+};
+
+void demonstrateAsyncSnapshots();
+
+#endif // MEMENTO_ASYNC_HPP
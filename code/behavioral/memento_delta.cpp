@@ -0,0 +1,48 @@
+#include "memento_delta.hpp"
+#include <chrono>
+#include <iostream>
+
+void demonstrateDeltaMemento() {
+    std::cout << "\n=== Delta Memento Demo ===\n" << std::endl;
+
+    TextEditor editor;
+    DeltaCaretaker caretaker(4);
+
+    editor.setContent("Hello");
+    caretaker.addMemento(editor.createMemento());
+    editor.setContent("Hello World");
+    caretaker.addMemento(editor.createMemento());
+    editor.setContent("Hello, World!");
+    caretaker.addMemento(editor.createMemento());
+    editor.setContent("Goodbye, World!");
+    caretaker.addMemento(editor.createMemento());
+    editor.showContent();
+
+    for (int i = caretaker.getMementoCount() - 2; i >= 0; --i) {
+        std::cout << "Restoring snapshot " << i << ": ";
+        editor.restoreFromMemento(caretaker.getMemento(i));
+        editor.showContent();
+    }
+
+    // A 1 MB document with 1000 one-character edits
+    std::cout << "\n1 MB document, 1000 snapshots of single-character edits:" << std::endl;
+    std::string document(1 << 20, 'a');
+    DeltaCaretaker large(64);
+    for (int i = 0; i < 1000; ++i) {
+        document[static_cast<std::size_t>(i) * 997 % document.size()] = static_cast<char>('b' + i % 20);
+        large.addState(document);
+    }
+    std::cout << "  Full-copy caretaker would hold " << 1000.0 * document.size() / (1 << 20)
+              << " MB" << std::endl;
+    std::cout << "  Delta caretaker holds " << static_cast<double>(large.getStoredBytes()) / (1 << 20)
+              << " MB" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    auto restored = large.getMemento(999);
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+    std::cout << "  Restoring the last snapshot took " << elapsed.count() << " us and "
+              << (restored->getState() == document ? "matches" : "does NOT match")
+              << " the document" << std::endl;
+
+    std::cout << "\n=== End Delta Memento Demo ===\n" << std::endl;
+}
@@ -0,0 +1,99 @@
+#ifndef MEMENTO_DELTA_HPP
+#define MEMENTO_DELTA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "memento.hpp"
+
+// Delta Caretaker: stores the edit between consecutive mementos instead of
+// each full document.
+//
+// Every snapshot is reduced to a single splice (position, erased length,
+// inserted text) against the previous one by trimming the common prefix and
+// suffix. Every keyframeInterval-th snapshot, or whenever the splice is not
+// much smaller than the document, the full content is kept instead.
+// getMemento(index) replays at most keyframeInterval splices from the nearest
+// keyframe, so memory grows with edit size and restores stay bounded.
+class DeltaCaretaker {
+    struct Snapshot {
+        bool keyframe;
+        std::string text;          // full content for keyframes, inserted text otherwise
+        std::size_t position;
+        std::size_t erased;
+    };
+
+    std::vector<Snapshot> snapshots_;
+    std::vector<int> keyframeIndex_;   // nearest keyframe at or before each snapshot
+    std::string latest_;
+    int keyframeInterval_;
+
+public:
+    explicit DeltaCaretaker(int keyframeInterval = 32)
+        : keyframeInterval_(keyframeInterval > 0 ? keyframeInterval : 1) {}
+
+    void addMemento(const std::shared_ptr<Memento>& memento) {
+        addState(memento->getState());
+    }
+
+    void addState(const std::string& state) {
+        int index = static_cast<int>(snapshots_.size());
+        int lastKeyframe = keyframeIndex_.empty() ? -1 : keyframeIndex_.back();
+
+        std::size_t prefix = 0;
+        std::size_t limit = std::min(latest_.size(), state.size());
+        while (prefix < limit && latest_[prefix] == state[prefix]) {
+            ++prefix;
+        }
+        std::size_t suffix = 0;
+        while (suffix < limit - prefix &&
+               latest_[latest_.size() - 1 - suffix] == state[state.size() - 1 - suffix]) {
+            ++suffix;
+        }
+        std::size_t inserted = state.size() - prefix - suffix;
+
+        bool keyframe = lastKeyframe < 0 || index - lastKeyframe >= keyframeInterval_ ||
+                        inserted > state.size() / 2;
+        if (keyframe) {
+            snapshots_.push_back(Snapshot{true, state, 0, 0});
+            keyframeIndex_.push_back(index);
+        } else {
+            snapshots_.push_back(Snapshot{false, state.substr(prefix, inserted), prefix,
+                                          latest_.size() - prefix - suffix});
+            keyframeIndex_.push_back(lastKeyframe);
+        }
+        latest_ = state;
+    }
+
+    std::shared_ptr<Memento> getMemento(int index) {
+        if (index < 0 || index >= static_cast<int>(snapshots_.size())) {
+            return nullptr;
+        }
+        int keyframe = keyframeIndex_[index];
+        std::string state = snapshots_[keyframe].text;
+        for (int i = keyframe + 1; i <= index; ++i) {
+            const Snapshot& delta = snapshots_[i];
+            state.replace(delta.position, delta.erased, delta.text);
+        }
+        return std::make_shared<Memento>(state);
+    }
+
+    int getMementoCount() const {
+        return static_cast<int>(snapshots_.size());
+    }
+
+    // Bytes of text held by the history (excluding the latest working copy)
+    std::size_t getStoredBytes() const {
+        std::size_t total = 0;
+        for (const auto& snapshot : snapshots_) {
+            total += snapshot.text.size();
+        }
+        return total;
+    }
+};
+
+void demonstrateDeltaMemento();
+
+#endif // MEMENTO_DELTA_HPP
@@ -0,0 +1,400 @@
+#include "memento_tiered.hpp"
+#include <chrono>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+// Minimal LZ77 codec, enough for text history without an external library.
+// A control byte below 0x80 starts a run of (c + 1) literal bytes; otherwise
+// it is a match of (c - 0x80 + 4) bytes at a 16-bit distance back.
+constexpr std::size_t kMinMatch = 4;
+constexpr std::size_t kMaxMatch = 0x7F + kMinMatch;
+constexpr std::size_t kMaxLiterals = 0x80;
+constexpr std::size_t kMaxDistance = 0xFFFF;
+constexpr int kHashBits = 14;
+
+std::uint32_t hash4(const char* p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return (value * 2654435761u) >> (32 - kHashBits);
+}
+
+std::vector<char> compress(const std::string& input) {
+    std::vector<char> out;
+    out.reserve(input.size() / 4 + 16);
+    std::vector<std::size_t> table(std::size_t(1) << kHashBits, SIZE_MAX);
+
+    const std::size_t size = input.size();
+    std::size_t literalStart = 0;
+    std::size_t position = 0;
+
+    auto flushLiterals = [&](std::size_t end) {
+        while (literalStart < end) {
+            std::size_t run = std::min(kMaxLiterals, end - literalStart);
+            out.push_back(static_cast<char>(run - 1));
+            out.insert(out.end(), input.data() + literalStart, input.data() + literalStart + run);
+            literalStart += run;
+        }
+    };
+
+    while (position + kMinMatch <= size) {
+        std::uint32_t h = hash4(input.data() + position);
+        std::size_t candidate = table[h];
+        table[h] = position;
+
+        if (candidate != SIZE_MAX && position - candidate <= kMaxDistance &&
+            std::memcmp(input.data() + candidate, input.data() + position, kMinMatch) == 0) {
+            std::size_t length = kMinMatch;
+            while (length < kMaxMatch && position + length < size &&
+                   input[candidate + length] == input[position + length]) {
+                ++length;
+            }
+            flushLiterals(position);
+            std::size_t distance = position - candidate;
+            out.push_back(static_cast<char>(0x80 + length - kMinMatch));
+            out.push_back(static_cast<char>(distance & 0xFF));
+            out.push_back(static_cast<char>(distance >> 8));
+            position += length;
+            literalStart = position;
+        } else {
+            ++position;
+        }
+    }
+    flushLiterals(size);
+    return out;
+}
+
+std::string decompress(const std::vector<char>& input) {
+    std::string out;
+    std::size_t position = 0;
+    while (position < input.size()) {
+        auto control = static_cast<unsigned char>(input[position++]);
+        if (control < 0x80) {
+            std::size_t run = control + 1u;
+            out.append(input.data() + position, run);
+            position += run;
+        } else {
+            std::size_t length = control - 0x80u + kMinMatch;
+            std::size_t distance = static_cast<unsigned char>(input[position]) |
+                                   (static_cast<std::size_t>(static_cast<unsigned char>(input[position + 1])) << 8);
+            position += 2;
+            // Byte by byte: a match may overlap the bytes it produces
+            std::size_t from = out.size() - distance;
+            for (std::size_t i = 0; i < length; ++i) {
+                out.push_back(out[from + i]);
+            }
+        }
+    }
+    return out;
+}
+
+// A delta holds the lengths of the prefix and suffix shared with the base,
+// then the compressed bytes between them
+std::vector<char> encodeDelta(const std::string& base, const std::string& text) {
+    std::uint64_t prefix = 0;
+    std::size_t shortest = std::min(base.size(), text.size());
+    while (prefix < shortest && base[prefix] == text[prefix]) {
+        ++prefix;
+    }
+    std::uint64_t suffix = 0;
+    while (suffix < shortest - prefix && base[base.size() - 1 - suffix] == text[text.size() - 1 - suffix]) {
+        ++suffix;
+    }
+    std::vector<char> middle = compress(text.substr(prefix, text.size() - prefix - suffix));
+
+    std::vector<char> out(2 * sizeof(std::uint64_t));
+    std::memcpy(out.data(), &prefix, sizeof(prefix));
+    std::memcpy(out.data() + sizeof(prefix), &suffix, sizeof(suffix));
+    out.insert(out.end(), middle.begin(), middle.end());
+    return out;
+}
+
+std::string applyDelta(const std::string& base, const std::vector<char>& delta) {
+    std::uint64_t prefix;
+    std::uint64_t suffix;
+    std::memcpy(&prefix, delta.data(), sizeof(prefix));
+    std::memcpy(&suffix, delta.data() + sizeof(prefix), sizeof(suffix));
+    std::string text = base.substr(0, prefix);
+    text += decompress(std::vector<char>(delta.begin() + 2 * sizeof(std::uint64_t), delta.end()));
+    text.append(base, base.size() - suffix, suffix);
+    return text;
+}
+
+}
+
+TieredCaretaker::TieredCaretaker(const std::string& spillPath, std::size_t hotCount,
+                                 std::size_t memoryBudget)
+    : hotCount_(hotCount), memoryBudget_(memoryBudget), warmBytes_(0), coldBytes_(0),
+      nextSpill_(0), spillPath_(spillPath), spillFd_(-1), spillData_(nullptr),
+      spillCapacity_(0), spillSize_(0), previousIndex_(SIZE_MAX), busy_(false), stopping_(false) {
+    spillFd_ = ::open(spillPath_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (spillFd_ < 0) {
+        throw std::runtime_error("Cannot open memento spill file: " + spillPath_);
+    }
+    worker_ = std::thread([this]() { backgroundLoop(); });
+}
+
+TieredCaretaker::~TieredCaretaker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    workCondition_.notify_all();
+    worker_.join();
+
+    if (spillData_ != nullptr) {
+        ::munmap(spillData_, spillCapacity_);
+    }
+    ::close(spillFd_);
+    // The spill file is scratch space for this caretaker only
+    std::remove(spillPath_.c_str());
+}
+
+void TieredCaretaker::addMemento(const std::shared_ptr<Memento>& memento) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.push_back(Entry{MementoTier::Hot, memento, {}, false, 0, 0, false});
+
+        // Demote the entry that just fell out of the hot window
+        if (entries_.size() > hotCount_) {
+            std::size_t index = entries_.size() - 1 - hotCount_;
+            if (!entries_[index].queued) {
+                entries_[index].queued = true;
+                compressQueue_.push_back(index);
+            }
+        }
+    }
+    workCondition_.notify_one();
+}
+
+std::shared_ptr<Memento> TieredCaretaker::getMemento(int index) {
+    auto start = std::chrono::steady_clock::now();
+    // The keyframe first, then the deltas up to the entry
+    std::vector<std::vector<char>> chain;
+    MementoTier tier;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (index < 0 || index >= static_cast<int>(entries_.size())) {
+            return nullptr;
+        }
+        const Entry& entry = entries_[index];
+        tier = entry.tier;
+        if (tier == MementoTier::Hot) {
+            auto memento = entry.memento;
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            readStats_[0].reads++;
+            readStats_[0].totalNanos += static_cast<std::uint64_t>(nanos);
+            readStats_[0].maxNanos = std::max(readStats_[0].maxNanos, static_cast<std::uint64_t>(nanos));
+            return memento;
+        }
+        // Every entry before a compressed one is compressed too
+        std::size_t first = static_cast<std::size_t>(index);
+        while (!entries_[first].keyframe) {
+            --first;
+        }
+        for (std::size_t i = first; i <= static_cast<std::size_t>(index); ++i) {
+            const Entry& link = entries_[i];
+            if (link.tier == MementoTier::Warm) {
+                chain.push_back(link.compressed);
+            } else {
+                chain.emplace_back(spillData_ + link.fileOffset, spillData_ + link.fileOffset + link.fileLength);
+            }
+        }
+    }
+
+    std::string text = decompress(chain.front());
+    for (std::size_t i = 1; i < chain.size(); ++i) {
+        text = applyDelta(text, chain[i]);
+    }
+    auto memento = std::make_shared<Memento>(std::move(text));
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    recordRead(tier, static_cast<std::uint64_t>(nanos));
+    return memento;
+}
+
+int TieredCaretaker::getMementoCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(entries_.size());
+}
+
+MementoTier TieredCaretaker::getTier(int index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index < 0 || index >= static_cast<int>(entries_.size())) {
+        return MementoTier::Hot;
+    }
+    return entries_[index].tier;
+}
+
+std::array<TierMetrics, 3> TieredCaretaker::getMetrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::array<TierMetrics, 3> metrics;
+    for (const auto& entry : entries_) {
+        metrics[static_cast<std::size_t>(entry.tier)].entries++;
+    }
+    Rope::Footprint hot;
+    for (const auto& entry : entries_) {
+        if (entry.tier == MementoTier::Hot) {
+            hot.add(entry.memento->getRope());
+        }
+    }
+    metrics[0].bytes = hot.getBytes();
+    metrics[1].bytes = warmBytes_;
+    metrics[2].bytes = coldBytes_;
+    for (std::size_t i = 0; i < metrics.size(); ++i) {
+        const ReadStats& stats = readStats_[i];
+        metrics[i].reads = stats.reads;
+        if (stats.reads > 0) {
+            metrics[i].avgReadMicros = static_cast<double>(stats.totalNanos) / stats.reads / 1000.0;
+        }
+        metrics[i].maxReadMicros = static_cast<double>(stats.maxNanos) / 1000.0;
+    }
+    return metrics;
+}
+
+void TieredCaretaker::waitForBackground() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCondition_.wait(lock, [this]() { return compressQueue_.empty() && !busy_; });
+}
+
+void TieredCaretaker::recordRead(MementoTier tier, std::uint64_t nanos) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReadStats& stats = readStats_[static_cast<std::size_t>(tier)];
+    stats.reads++;
+    stats.totalNanos += nanos;
+    stats.maxNanos = std::max(stats.maxNanos, nanos);
+}
+
+void TieredCaretaker::backgroundLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        workCondition_.wait(lock, [this]() { return stopping_ || !compressQueue_.empty(); });
+        if (compressQueue_.empty()) {
+            return;
+        }
+        std::size_t index = compressQueue_.front();
+        compressQueue_.pop_front();
+        busy_ = true;
+
+        // Mementos are immutable, so compress without holding the lock.
+        // Entries are queued in order, so the previous one was the last done.
+        auto memento = entries_[index].memento;
+        lock.unlock();
+        std::string text = memento->getState();
+        bool keyframe = previousIndex_ + 1 != index || index % kKeyframeInterval == 0;
+        std::vector<char> compressed = keyframe ? compress(text) : encodeDelta(previousText_, text);
+        previousText_ = std::move(text);
+        previousIndex_ = index;
+        memento.reset();
+        lock.lock();
+
+        Entry& entry = entries_[index];
+        warmBytes_ += compressed.size();
+        entry.compressed = std::move(compressed);
+        entry.keyframe = keyframe;
+        entry.memento.reset();
+        entry.tier = MementoTier::Warm;
+        spillLocked();
+
+        busy_ = false;
+        if (compressQueue_.empty()) {
+            idleCondition_.notify_all();
+        }
+    }
+}
+
+void TieredCaretaker::spillLocked() {
+    while (warmBytes_ > memoryBudget_ && nextSpill_ < entries_.size()) {
+        Entry& entry = entries_[nextSpill_];
+        if (entry.tier == MementoTier::Hot) {
+            break;
+        }
+        if (entry.tier == MementoTier::Warm) {
+            std::size_t length = entry.compressed.size();
+            if (spillSize_ + length > spillCapacity_) {
+                std::size_t capacity = std::max({spillCapacity_ * 2, spillSize_ + length, std::size_t(1) << 20});
+                if (::ftruncate(spillFd_, static_cast<off_t>(capacity)) != 0) {
+                    return;
+                }
+                void* mapping = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, spillFd_, 0);
+                if (mapping == MAP_FAILED) {
+                    return;
+                }
+                if (spillData_ != nullptr) {
+                    ::munmap(spillData_, spillCapacity_);
+                }
+                spillData_ = static_cast<char*>(mapping);
+                spillCapacity_ = capacity;
+            }
+
+            std::memcpy(spillData_ + spillSize_, entry.compressed.data(), length);
+            entry.fileOffset = spillSize_;
+            entry.fileLength = length;
+            spillSize_ += length;
+            std::vector<char>().swap(entry.compressed);
+            entry.tier = MementoTier::Cold;
+            warmBytes_ -= length;
+            coldBytes_ += length;
+        }
+        ++nextSpill_;
+    }
+}
+
+void demonstrateTieredCaretaker() {
+    std::cout << "\n=== Tiered Caretaker Demo ===\n" << std::endl;
+
+    // Keep 8 hot mementos and 256 KB of compressed ones, spill the rest
+    TieredCaretaker caretaker("tiered_caretaker.spill", 8, 256 << 10);
+    TextEditor editor;
+    std::string base;
+    for (int i = 0; i < 2000; ++i) {
+        base += "Line " + std::to_string(i) + " of a long document.\n";
+    }
+    editor.setContent(base);
+
+    for (int i = 0; i < 200; ++i) {
+        editor.insertText(editor.getLength() / 2, "edit " + std::to_string(i) + "\n");
+        caretaker.addMemento(editor.createMemento());
+    }
+    caretaker.waitForBackground();
+
+    const char* names[] = {"Hot", "Warm", "Cold"};
+    for (int index : {199, 180, 0}) {
+        auto memento = caretaker.getMemento(index);
+        std::cout << "Snapshot " << index << " (" << names[static_cast<int>(caretaker.getTier(index))]
+                  << "): " << memento->getState().size() << " bytes" << std::endl;
+    }
+
+    std::cout << "\nTier metrics:" << std::endl;
+    auto metrics = caretaker.getMetrics();
+    for (std::size_t i = 0; i < metrics.size(); ++i) {
+        std::cout << "  " << names[i] << ": " << metrics[i].entries << " entries, "
+                  << metrics[i].bytes << " bytes, " << metrics[i].reads << " reads, avg "
+                  << metrics[i].avgReadMicros << " us" << std::endl;
+    }
+    std::cout << "  In memory: " << (metrics[0].bytes + metrics[1].bytes) / 1024 << " KB, a flattened copy of "
+              << "the document is " << editor.getLength() / 1024 << " KB" << std::endl;
+
+    std::cout << "\n=== End Tiered Caretaker Demo ===\n" << std::endl;
+}
+
+#else
+
+void demonstrateTieredCaretaker() {
+    std::cout << "\n=== Tiered Caretaker Demo ===\n" << std::endl;
+    std::cout << "The memory-mapped spill file needs a POSIX platform" << std::endl;
+    std::cout << "\n=== End Tiered Caretaker Demo ===\n" << std::endl;
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef MEMENTO_TIERED_HPP
+#define MEMENTO_TIERED_HPP
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "memento.hpp"
+
+// Where a memento currently lives
+enum class MementoTier {
+    Hot,   // the Memento object itself
+    Warm,  // compressed in memory
+    Cold   // compressed in the spill file
+};
+
+struct TierMetrics {
+    std::size_t entries = 0;
+    // Hot: memory the mementos retain, shared rope nodes counted once.
+    // Warm/cold: compressed bytes.
+    std::size_t bytes = 0;
+    std::uint64_t reads = 0;
+    double avgReadMicros = 0.0;
+    double maxReadMicros = 0.0;
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// Tiered Caretaker: a Caretaker for long undo histories.
+//
+// The newest hotCount mementos stay as they are. Older ones are compressed by
+// a background thread, and once compressed history exceeds memoryBudget
+// bytes the oldest compressed entries move to a memory-mapped spill file.
+// getMemento(index) works the same for every tier; warm and cold entries are
+// decompressed into a fresh Memento on demand.
+//
+// Consecutive mementos share most of their rope, so compressing each one on
+// its own would take more memory than keeping it hot. Instead, an entry is
+// stored as the region that differs from the previous entry, and only every
+// kKeyframeInterval-th entry holds the whole document. Reading an older
+// entry replays at most that many deltas from its keyframe.
+class TieredCaretaker {
+    static constexpr std::size_t kKeyframeInterval = 32;
+
+    struct Entry {
+        MementoTier tier = MementoTier::Hot;
+        std::shared_ptr<Memento> memento;
+        // The whole document for a keyframe, otherwise a delta
+        std::vector<char> compressed;
+        bool keyframe = false;
+        std::size_t fileOffset = 0;
+        std::size_t fileLength = 0;
+        bool queued = false;
+    };
+
+    struct ReadStats {
+        std::uint64_t reads = 0;
+        std::uint64_t totalNanos = 0;
+        std::uint64_t maxNanos = 0;
+    };
+
+    std::deque<Entry> entries_;
+    std::size_t hotCount_;
+    std::size_t memoryBudget_;
+    std::size_t warmBytes_;
+    std::size_t coldBytes_;
+    std::size_t nextSpill_;       // oldest entry that may still be warm
+    std::array<ReadStats, 3> readStats_;
+
+    std::string spillPath_;
+    int spillFd_;
+    char* spillData_;
+    std::size_t spillCapacity_;
+    std::size_t spillSize_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable workCondition_;
+    std::condition_variable idleCondition_;
+    std::deque<std::size_t> compressQueue_;
+    // Background thread only: the last entry it compressed, flattened
+    std::string previousText_;
+    std::size_t previousIndex_;
+    bool busy_;
+    bool stopping_;
+    std::thread worker_;
+
+public:
+    TieredCaretaker(const std::string& spillPath, std::size_t hotCount = 16,
+                    std::size_t memoryBudget = 64 << 20);
+    ~TieredCaretaker();
+
+    TieredCaretaker(const TieredCaretaker&) = delete;
+    TieredCaretaker& operator=(const TieredCaretaker&) = delete;
+
+    void addMemento(const std::shared_ptr<Memento>& memento);
+    std::shared_ptr<Memento> getMemento(int index);
+    int getMementoCount() const;
+
+    MementoTier getTier(int index) const;
+    std::array<TierMetrics, 3> getMetrics() const;
+    // Blocks until queued compression and spilling are done
+    void waitForBackground();
+
+private:
+    void backgroundLoop();
+    void spillLocked();
+    void recordRead(MementoTier tier, std::uint64_t nanos);
+};
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+void demonstrateTieredCaretaker();
+
+#endif // MEMENTO_TIERED_HPP
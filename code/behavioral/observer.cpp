@@ -1,5 +1,88 @@
 #include "observer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <random>
 #include <iostream>
+#include <thread>
+
+void WeatherStation::notifyObserversAsync(WorkStealingPool& pool, std::function<void()> onComplete,
+                                          std::size_t chunkSize) {
+    // Shared by every task of one notification; the views keep the observer
+    // arrays alive until the last task lets go of them
+    struct Notification {
+        RcuSlotMap<std::shared_ptr<Observer>>::View view;
+        RcuSlotMap<std::shared_ptr<Observer>>::View sequentialView;
+        float temperature;
+        float humidity;
+        float pressure;
+        std::atomic<std::size_t> remaining{0};
+        std::function<void()> onComplete;
+
+        Notification(const RcuSlotMap<std::shared_ptr<Observer>>& observers,
+                     const RcuSlotMap<std::shared_ptr<Observer>>& sequentialObservers, float t, float h, float p,
+                     std::function<void()> done)
+            : view(observers), sequentialView(sequentialObservers), temperature(t), humidity(h), pressure(p),
+              onComplete(std::move(done)) {}
+
+        void deliver(const RcuSlotMap<std::shared_ptr<Observer>>::View& observers, std::size_t begin,
+                     std::size_t end) const {
+            observers.forEach(begin, end, [this](const std::shared_ptr<Observer>& observer) {
+                observer->update(temperature, humidity, pressure);
+            });
+        }
+
+        void finishOne() {
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 && onComplete) {
+                onComplete();
+            }
+        }
+    };
+
+    auto notification = std::make_shared<Notification>(observers_, sequentialObservers_, temperature_, humidity_,
+                                                       pressure_, std::move(onComplete));
+    std::size_t count = notification->view.size();
+    std::size_t sequentialCount = notification->sequentialView.size();
+
+    // A few chunks per thread for balance, each a run of neighbouring entries
+    // big enough that the per-task overhead stays small
+    constexpr std::size_t kMinChunk = 64;
+    constexpr std::size_t kMaxChunk = 1024;
+    if (chunkSize == 0) {
+        chunkSize = std::clamp<std::size_t>(count / (pool.getThreadCount() * 4), kMinChunk, kMaxChunk);
+    }
+    std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+    std::size_t tasks = chunks + (sequentialCount > 0 ? 1 : 0);
+    if (tasks == 0) {
+        // Nobody to notify; onComplete still runs on the pool
+        notification->remaining.store(1, std::memory_order_relaxed);
+        pool.submit([notification]() { notification->finishOne(); });
+        return;
+    }
+    notification->remaining.store(tasks, std::memory_order_relaxed);
+
+    for (std::size_t begin = 0; begin < count; begin += chunkSize) {
+        pool.submit([notification, begin, end = begin + chunkSize]() {
+            notification->deliver(notification->view, begin, end);
+            notification->finishOne();
+        });
+    }
+    if (sequentialCount > 0) {
+        sequential_.post(pool, [notification, sequentialCount]() {
+            notification->deliver(notification->sequentialView, 0, sequentialCount);
+            notification->finishOne();
+        });
+    }
+}
+
+void WeatherStation::notifyObserversParallel(WorkStealingPool& pool, std::size_t chunkSize) {
+    std::atomic<bool> done{false};
+    notifyObserversAsync(pool, [&done]() { done.store(true, std::memory_order_release); }, chunkSize);
+    pool.helpUntil([&done]() { return done.load(std::memory_order_acquire); });
+}
 
 void demonstrateObserverPattern() {
     std::cout << "\n=== Observer Pattern Demo ===\n" << std::endl;
@@ -24,4 +107,227 @@ void demonstrateObserverPattern() {
     weatherStation->setMeasurements(24.8f, 60.0f, 1014.00f);
 
     std::cout << "=== End Observer Pattern Demo ===\n" << std::endl;
-} 
\ No newline at end of file
+} 
+
+namespace {
+
+// Counts updates; safe to share between notifying threads
+class CountingDisplay : public Observer {
+    std::atomic<std::uint64_t> updates_{0};
+public:
+    void update(float, float, float) override {
+        updates_.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::uint64_t getUpdates() const { return updates_.load(); }
+};
+
+// Unsubscribes itself from inside its first update
+class OneShotDisplay : public Observer {
+    WeatherStation& station_;
+    ObserverHandle handle_;
+    std::atomic<int> updates_{0};
+public:
+    explicit OneShotDisplay(WeatherStation& station) : station_(station) {}
+    void setHandle(ObserverHandle handle) { handle_ = handle; }
+    void update(float, float, float) override {
+        if (updates_.fetch_add(1) == 0) {
+            station_.removeObserver(handle_);
+        }
+    }
+    int getUpdates() const { return updates_.load(); }
+};
+
+} // namespace
+
+void demonstrateConcurrentObservers() {
+    std::cout << "\n=== Concurrent Observer Demo ===\n" << std::endl;
+
+    WeatherStation station;
+    station.setMeasurements(21.0f, 55.0f, 1015.0f);
+
+    auto steady = std::make_shared<CountingDisplay>();
+    station.registerObserver(steady);
+    auto oneShot = std::make_shared<OneShotDisplay>(station);
+    oneShot->setHandle(station.registerObserver(oneShot));
+
+    // Two threads notify continuously while a third churns subscriptions
+    constexpr int kNotifications = 20'000;
+    constexpr int kChurn = 2'000;
+    std::vector<std::thread> notifiers;
+    for (int t = 0; t < 2; ++t) {
+        notifiers.emplace_back([&] {
+            for (int i = 0; i < kNotifications; ++i) {
+                station.notifyObservers();
+            }
+        });
+    }
+    std::thread churner([&] {
+        std::deque<ObserverHandle> transient;
+        for (int i = 0; i < kChurn; ++i) {
+            transient.push_back(station.registerObserver(std::make_shared<CountingDisplay>()));
+            if (transient.size() > 8) {
+                station.removeObserver(transient.front());
+                transient.pop_front();
+            }
+        }
+        for (auto handle : transient) {
+            station.removeObserver(handle);
+        }
+    });
+
+    for (auto& notifier : notifiers) {
+        notifier.join();
+    }
+    churner.join();
+    EpochDomain::instance().reclaim();
+
+    std::cout << "Steady display received " << steady->getUpdates() << " of "
+              << 2 * kNotifications << " notifications" << std::endl;
+    std::cout << "One-shot display received " << oneShot->getUpdates()
+              << " notification(s) before unsubscribing itself" << std::endl;
+    std::cout << "Observers left: " << station.getObserverCount() << std::endl;
+    std::cout << "Old observer lists awaiting reclamation: "
+              << EpochDomain::instance().getPendingCount() << std::endl;
+
+    std::cout << "\n=== End Concurrent Observer Demo ===\n" << std::endl;
+}
+
+void benchmarkObserverChurn(std::size_t observers, std::size_t churn) {
+    std::cout << "\n=== Observer Churn Benchmark ===\n" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    auto seconds = [](Clock::duration elapsed) {
+        return std::chrono::duration<double>(elapsed).count();
+    };
+
+    WeatherStation station;
+    auto display = std::make_shared<CountingDisplay>();
+    std::vector<ObserverHandle> handles(observers);
+    std::mt19937 random(7);
+
+    auto start = Clock::now();
+    for (auto& handle : handles) {
+        handle = station.registerObserver(display);
+    }
+    double registerTime = seconds(Clock::now() - start);
+
+    // Replace one random subscriber at a time
+    start = Clock::now();
+    for (std::size_t i = 0; i < churn; ++i) {
+        std::size_t victim = random() % observers;
+        station.removeObserver(handles[victim]);
+        handles[victim] = station.registerObserver(display);
+    }
+    double churnTime = seconds(Clock::now() - start);
+
+    start = Clock::now();
+    constexpr int kNotifications = 100;
+    for (int i = 0; i < kNotifications; ++i) {
+        station.notifyObservers();
+    }
+    double notifyTime = seconds(Clock::now() - start);
+
+    std::cout << "Registered " << observers << " observers in " << registerTime * 1e3 << " ms" << std::endl;
+    std::cout << churn << " unsubscribe/subscribe pairs in " << churnTime * 1e3 << " ms ("
+              << churnTime * 1e9 / static_cast<double>(churn) << " ns per pair)" << std::endl;
+    std::cout << "Notify " << station.getObserverCount() << " observers: "
+              << notifyTime * 1e9 / (kNotifications * static_cast<double>(observers))
+              << " ns per observer" << std::endl;
+
+    // The pointer-based removal has to search, so only a sample is timed
+    std::size_t sample = std::min<std::size_t>(observers, 1000);
+    std::vector<std::shared_ptr<Observer>> distinct;
+    WeatherStation byPointer;
+    for (std::size_t i = 0; i < observers; ++i) {
+        distinct.push_back(std::make_shared<CountingDisplay>());
+        byPointer.registerObserver(distinct.back());
+    }
+    start = Clock::now();
+    for (std::size_t i = 0; i < sample; ++i) {
+        byPointer.removeObserver(distinct[observers - 1 - i]);
+    }
+    double pointerTime = seconds(Clock::now() - start);
+    std::cout << "Removal by pointer search: " << pointerTime * 1e9 / static_cast<double>(sample)
+              << " ns per observer" << std::endl;
+
+    std::cout << "\n=== End Observer Churn Benchmark ===\n" << std::endl;
+}
+
+namespace {
+
+// Does a slice of real work per update, like a display that recomputes a
+// forecast. Overlapping notifications may call it concurrently.
+class ForecastDisplay : public Observer {
+    std::atomic<std::uint64_t>& updates_;
+    std::atomic<float> forecast_{0.0f};
+public:
+    explicit ForecastDisplay(std::atomic<std::uint64_t>& updates) : updates_(updates) {}
+    void update(float temperature, float humidity, float pressure) override {
+        float value = temperature;
+        for (int i = 0; i < 32; ++i) {
+            value = value * 0.9f + std::sqrt(humidity + pressure * 0.001f + static_cast<float>(i));
+        }
+        forecast_.store(value, std::memory_order_relaxed);
+        updates_.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+// Records the temperatures it sees so their order can be checked
+class SequenceRecorder : public Observer {
+    std::vector<float> seen_;
+public:
+    void update(float temperature, float, float) override { seen_.push_back(temperature); }
+    bool inOrder() const { return std::is_sorted(seen_.begin(), seen_.end()); }
+    std::size_t getCount() const { return seen_.size(); }
+};
+
+} // namespace
+
+void demonstrateParallelNotification(std::size_t observers) {
+    std::cout << "\n=== Parallel Notification Demo ===\n" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    WeatherStation station;
+    std::atomic<std::uint64_t> updates{0};
+    for (std::size_t i = 0; i < observers; ++i) {
+        station.registerObserver(std::make_shared<ForecastDisplay>(updates));
+    }
+    auto recorder = std::make_shared<SequenceRecorder>();
+    station.registerObserver(recorder, NotifyOrder::Sequential);
+
+    constexpr int kRounds = 20;
+    auto start = Clock::now();
+    for (int i = 0; i < kRounds; ++i) {
+        station.setMeasurements(20.0f + static_cast<float>(i), 50.0f, 1013.0f);
+    }
+    double sequentialMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / kRounds;
+
+    WorkStealingPool pool;
+    start = Clock::now();
+    for (int i = 0; i < kRounds; ++i) {
+        station.setMeasurements(40.0f + static_cast<float>(i), 50.0f, 1013.0f, pool);
+    }
+    double parallelMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / kRounds;
+
+    // Fire-and-forget notifications overlap; the sequential observer still
+    // sees them one at a time and in publication order
+    std::atomic<int> completed{0};
+    start = Clock::now();
+    for (int i = 0; i < kRounds; ++i) {
+        station.setMeasurementsAsync(60.0f + static_cast<float>(i), 50.0f, 1013.0f, pool,
+                                     [&completed]() { completed.fetch_add(1); });
+    }
+    pool.helpUntil([&completed]() { return completed.load() == kRounds; });
+    double asyncMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / kRounds;
+
+    std::cout << observers << " observers on " << pool.getThreadCount() << " pool thread(s):" << std::endl;
+    std::cout << "  Sequential notify: " << sequentialMs << " ms" << std::endl;
+    std::cout << "  Parallel notify: " << parallelMs << " ms" << std::endl;
+    std::cout << "  Overlapping async notifies: " << asyncMs << " ms each" << std::endl;
+    std::cout << "  Updates delivered: " << updates.load() << ", tasks stolen: " << pool.getStolenCount()
+              << std::endl;
+    std::cout << "  Sequential observer saw " << recorder->getCount() << " updates, "
+              << (recorder->inOrder() ? "in order" : "OUT OF ORDER") << std::endl;
+
+    std::cout << "\n=== End Parallel Notification Demo ===\n" << std::endl;
+}
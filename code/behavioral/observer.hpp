@@ -1,10 +1,18 @@
 #ifndef OBSERVER_HPP
 #define OBSERVER_HPP
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <vector>
+#include <functional>
 #include <memory>
+#include <span>
+#include "rcu.hpp"
+#include "timeseries_store.hpp"
+#include "window_stats.hpp"
+#include "work_stealing_pool.hpp"
 
 // Forward declarations
 class Observer;
@@ -15,41 +23,109 @@ class Observer {
 public:
     virtual ~Observer() = default;
     virtual void update(float temperature, float humidity, float pressure) = 0;
+    
+    // Called once per ingested batch; by default only the latest reading is seen
+    virtual void updateBatch(std::span<const WeatherReading> readings) {
+        if (!readings.empty()) {
+            const WeatherReading& latest = readings.back();
+            update(latest.temperature, latest.humidity, latest.pressure);
+        }
+    }
 };
 
+// Identifies one registration; returned by registerObserver
+using ObserverHandle = SlotHandle;
+
 // Subject interface
 class Subject {
 public:
     virtual ~Subject() = default;
-    virtual void registerObserver(std::shared_ptr<Observer> observer) = 0;
-    virtual void removeObserver(std::shared_ptr<Observer> observer) = 0;
+    virtual ObserverHandle registerObserver(std::shared_ptr<Observer> observer) = 0;
+    virtual bool removeObserver(ObserverHandle handle) = 0;
+    // Linear search by pointer; prefer the handle
+    virtual bool removeObserver(const std::shared_ptr<Observer>& observer) = 0;
     virtual void notifyObservers() = 0;
 };
 
+// How parallel notifications may reach an observer
+enum class NotifyOrder {
+    Any,        // possibly concurrently with other notifications, in any order
+    Sequential  // one notification at a time, in the order they were published
+};
+
 // Concrete Subject: Weather Station
+// Observers may be registered and removed from any thread, including from
+// inside update(), while notifications are running on other threads.
+// Registration returns a handle that removes the observer in O(1).
+// Sequential observers are kept in a list of their own, so the strand that
+// serves them only walks that list, and is not used at all while it is empty.
 class WeatherStation : public Subject {
-    std::vector<std::shared_ptr<Observer>> observers_;
+    // Set in the handles of Sequential registrations
+    static constexpr std::uint32_t kSequentialBit = 1u << 31;
+
+    RcuSlotMap<std::shared_ptr<Observer>> observers_;
+    RcuSlotMap<std::shared_ptr<Observer>> sequentialObservers_;
+    Strand sequential_;
+    std::shared_ptr<TimeSeriesStore> store_;
     float temperature_;
     float humidity_;
     float pressure_;
 public:
     WeatherStation() : temperature_(0.0f), humidity_(0.0f), pressure_(0.0f) {}
     
-    void registerObserver(std::shared_ptr<Observer> observer) override {
-        observers_.push_back(observer);
+    ObserverHandle registerObserver(std::shared_ptr<Observer> observer) override {
+        return registerObserver(std::move(observer), NotifyOrder::Any);
+    }
+    
+    ObserverHandle registerObserver(std::shared_ptr<Observer> observer, NotifyOrder order) {
+        if (order == NotifyOrder::Sequential) {
+            ObserverHandle handle = sequentialObservers_.insert(std::move(observer));
+            handle.index |= kSequentialBit;
+            return handle;
+        }
+        return observers_.insert(std::move(observer));
+    }
+    
+    bool removeObserver(ObserverHandle handle) override {
+        if (handle.index & kSequentialBit) {
+            handle.index &= ~kSequentialBit;
+            return sequentialObservers_.erase(handle);
+        }
+        return observers_.erase(handle);
     }
     
-    void removeObserver(std::shared_ptr<Observer> observer) override {
-        observers_.erase(
-            std::remove(observers_.begin(), observers_.end(), observer),
-            observers_.end()
-        );
+    bool removeObserver(const std::shared_ptr<Observer>& observer) override {
+        auto matches = [&observer](const std::shared_ptr<Observer>& registered) {
+            return registered == observer;
+        };
+        return observers_.eraseFirstIf(matches) || sequentialObservers_.eraseFirstIf(matches);
     }
     
     void notifyObservers() override {
-        for (auto& observer : observers_) {
+        auto update = [this](const std::shared_ptr<Observer>& observer) {
             observer->update(temperature_, humidity_, pressure_);
-        }
+        };
+        observers_.forEach(update);
+        sequentialObservers_.forEach(update);
+    }
+    
+    // Splits the observer list into chunks that run as tasks on the pool;
+    // Sequential observers are updated from one task on a strand. Returns at
+    // once; onComplete runs on a pool thread after the last observer.
+    // chunkSize 0 picks one from the list size and the pool size.
+    //
+    // The station may be destroyed while notifications are in flight: they
+    // hold on to the observer lists and the strand queue they were started
+    // with and still reach every observer. An observer removed in the
+    // meantime is skipped by whatever has not reached it yet.
+    void notifyObserversAsync(WorkStealingPool& pool, std::function<void()> onComplete = nullptr,
+                              std::size_t chunkSize = 0);
+    
+    // Same, but waits for completion, helping the pool in the meantime
+    void notifyObserversParallel(WorkStealingPool& pool, std::size_t chunkSize = 0);
+    
+    std::size_t getObserverCount() const {
+        return observers_.size() + sequentialObservers_.size();
     }
     
     void setMeasurements(float temperature, float humidity, float pressure) {
@@ -58,6 +134,47 @@ public:
         pressure_ = pressure;
         notifyObservers();
     }
+    
+    // Parallel counterparts: blocking, and returning at once
+    void setMeasurements(float temperature, float humidity, float pressure, WorkStealingPool& pool) {
+        temperature_ = temperature;
+        humidity_ = humidity;
+        pressure_ = pressure;
+        notifyObserversParallel(pool);
+    }
+    
+    void setMeasurementsAsync(float temperature, float humidity, float pressure, WorkStealingPool& pool,
+                              std::function<void()> onComplete = nullptr) {
+        temperature_ = temperature;
+        humidity_ = humidity;
+        pressure_ = pressure;
+        notifyObserversAsync(pool, std::move(onComplete));
+    }
+    
+    // Batched readings are kept in the store, if one is attached
+    void attachStore(std::shared_ptr<TimeSeriesStore> store) {
+        store_ = std::move(store);
+    }
+    
+    // Ingests a batch of readings in timestamp order and notifies each
+    // observer once for the whole batch
+    void setMeasurements(std::span<const WeatherReading> readings) {
+        if (readings.empty()) {
+            return;
+        }
+        if (store_) {
+            store_->append(readings);
+        }
+        const WeatherReading& latest = readings.back();
+        temperature_ = latest.temperature;
+        humidity_ = latest.humidity;
+        pressure_ = latest.pressure;
+        auto update = [readings](const std::shared_ptr<Observer>& observer) {
+            observer->updateBatch(readings);
+        };
+        observers_.forEach(update);
+        sequentialObservers_.forEach(update);
+    }
 };
 
 // Concrete Observer: Current Conditions Display
@@ -76,33 +193,50 @@ public:
 };
 
 // Concrete Observer: Statistics Display
+// Temperature statistics over a sliding window (the last 100 readings by
+// default)
 class StatisticsDisplay : public Observer {
     std::string name_;
-    float min_temp_, max_temp_, avg_temp_;
-    int readings_;
+    SlidingWindowStats temperatures_;
 public:
-    explicit StatisticsDisplay(const std::string& name) 
-        : name_(name), min_temp_(0.0f), max_temp_(0.0f), avg_temp_(0.0f), readings_(0) {}
+    explicit StatisticsDisplay(const std::string& name, WindowConfig window = {100})
+        : name_(name), temperatures_(window) {}
     
     void update(float temperature, float humidity, float pressure) override {
-        if (readings_ == 0) {
-            min_temp_ = max_temp_ = avg_temp_ = temperature;
-        } else {
-            min_temp_ = std::min(min_temp_, temperature);
-            max_temp_ = std::max(max_temp_, temperature);
-            avg_temp_ = (avg_temp_ * readings_ + temperature) / (readings_ + 1);
+        (void)humidity;
+        (void)pressure;
+        temperatures_.add(temperature);
+        display();
+    }
+    
+    // Folds the whole batch into the window, then displays once
+    void updateBatch(std::span<const WeatherReading> readings) override {
+        for (const auto& reading : readings) {
+            temperatures_.add(reading.temperature);
         }
-        readings_++;
-        
+        display();
+    }
+    
+    const SlidingWindowStats& getStatistics() const {
+        return temperatures_;
+    }
+    
+private:
+    void display() const {
         std::cout << name_ << " - Statistics:" << std::endl;
-        std::cout << "  Min Temperature: " << min_temp_ << "°C" << std::endl;
-        std::cout << "  Max Temperature: " << max_temp_ << "°C" << std::endl;
-        std::cout << "  Avg Temperature: " << avg_temp_ << "°C" << std::endl;
-        std::cout << "  Readings: " << readings_ << std::endl;
+        std::cout << "  Min Temperature: " << temperatures_.getMin() << "°C" << std::endl;
+        std::cout << "  Max Temperature: " << temperatures_.getMax() << "°C" << std::endl;
+        std::cout << "  Avg Temperature: " << temperatures_.getMean() << "°C" << std::endl;
+        std::cout << "  Std Deviation: " << temperatures_.getStdDev() << "°C" << std::endl;
+        std::cout << "  95th Percentile: " << temperatures_.getPercentile(95) << "°C" << std::endl;
+        std::cout << "  Readings: " << temperatures_.getTotalCount() << std::endl;
         std::cout << std::endl;
     }
 };
 
 void demonstrateObserverPattern();
+void demonstrateConcurrentObservers();
+void demonstrateParallelNotification(std::size_t observers = 50'000);
+void benchmarkObserverChurn(std::size_t observers = 100'000, std::size_t churn = 100'000);
 
 #endif // OBSERVER_HPP 
\ No newline at end of file
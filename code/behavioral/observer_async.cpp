@@ -0,0 +1,246 @@
+#include "observer_async.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct PendingReading {
+    float temperature;
+    float humidity;
+    float pressure;
+    Clock::time_point publishedAt;
+};
+
+}
+
+// Proxy observer: one target's pending readings plus its delivery counters
+class AsyncNotifier::AsyncObserver : public Observer, public std::enable_shared_from_this<AsyncObserver> {
+public:
+    AsyncNotifier& notifier;
+    std::shared_ptr<Observer> target;
+    std::string name;
+    DeliveryMode mode;
+    std::size_t capacity;
+
+    std::mutex mutex;
+    std::deque<PendingReading> queue;
+    bool scheduled = false;
+    std::size_t maxDepth = 0;
+    std::uint64_t published = 0;
+    std::uint64_t delivered = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t lagTotalNanos = 0;
+    std::uint64_t lagMaxNanos = 0;
+
+    AsyncObserver(AsyncNotifier& owner, std::shared_ptr<Observer> observer, std::string observerName,
+                  DeliveryMode deliveryMode, std::size_t queueCapacity)
+        : notifier(owner), target(std::move(observer)), name(std::move(observerName)),
+          mode(deliveryMode), capacity(std::max<std::size_t>(1, queueCapacity)) {}
+
+    void update(float temperature, float humidity, float pressure) override {
+        PendingReading reading{temperature, humidity, pressure, Clock::now()};
+        bool schedule = false;
+        std::uint64_t droppedNow = 0;
+        // Counted before it becomes visible, so flush() can never see zero early
+        notifier.pending_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++published;
+            std::size_t limit = mode == DeliveryMode::Conflate ? 1 : capacity;
+            while (queue.size() >= limit) {
+                queue.pop_front();
+                ++droppedNow;
+            }
+            queue.push_back(reading);
+            dropped += droppedNow;
+            maxDepth = std::max(maxDepth, queue.size());
+            if (!scheduled) {
+                scheduled = schedule = true;
+            }
+        }
+
+        if (droppedNow > 0) {
+            notifier.completed(droppedNow);
+        }
+        if (schedule) {
+            notifier.schedule(*this);
+        }
+    }
+};
+
+AsyncNotifier::AsyncNotifier(WorkStealingPool& pool, std::size_t queueCapacity)
+    : pool_(pool), queueCapacity_(queueCapacity), pending_(0) {}
+
+AsyncNotifier::~AsyncNotifier() {
+    // Drain tasks still queued on the pool refer back to the notifier
+    flush();
+}
+
+std::shared_ptr<Observer> AsyncNotifier::makeAsync(std::shared_ptr<Observer> target,
+                                                   const std::string& name, DeliveryMode mode) {
+    auto observer = std::make_shared<AsyncObserver>(*this, std::move(target), name, mode, queueCapacity_);
+    std::lock_guard<std::mutex> lock(observersMutex_);
+    observers_.push_back(observer);
+    return observer;
+}
+
+void AsyncNotifier::schedule(AsyncObserver& observer) {
+    pool_.submit([this, observer = observer.shared_from_this()]() { drain(*observer); });
+}
+
+void AsyncNotifier::drain(AsyncObserver& observer) {
+    // Deliver a bounded batch, then requeue, so one slow observer cannot hog
+    // a worker while others wait
+    constexpr std::size_t kBatch = 16;
+
+    std::uint64_t count = 0;
+    while (count < kBatch) {
+        PendingReading reading;
+        {
+            std::lock_guard<std::mutex> lock(observer.mutex);
+            if (observer.queue.empty()) {
+                break;
+            }
+            reading = observer.queue.front();
+            observer.queue.pop_front();
+            auto lag = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - reading.publishedAt).count());
+            observer.lagTotalNanos += lag;
+            observer.lagMaxNanos = std::max(observer.lagMaxNanos, lag);
+            ++observer.delivered;
+        }
+        observer.target->update(reading.temperature, reading.humidity, reading.pressure);
+        ++count;
+    }
+
+    bool more = false;
+    {
+        std::lock_guard<std::mutex> lock(observer.mutex);
+        more = !observer.queue.empty();
+        observer.scheduled = more;
+    }
+    if (more) {
+        schedule(observer);
+    }
+    if (count > 0) {
+        completed(count);
+    }
+}
+
+void AsyncNotifier::completed(std::uint64_t count) {
+    if (pending_.fetch_sub(count, std::memory_order_acq_rel) == count) {
+        pending_.notify_all();
+    }
+}
+
+void AsyncNotifier::flush() {
+    for (std::uint64_t pending = pending_.load(std::memory_order_acquire); pending != 0;
+         pending = pending_.load(std::memory_order_acquire)) {
+        pending_.wait(pending, std::memory_order_acquire);
+    }
+}
+
+std::vector<ObserverDeliveryMetrics> AsyncNotifier::getMetrics() const {
+    std::vector<ObserverDeliveryMetrics> metrics;
+    std::lock_guard<std::mutex> observersLock(observersMutex_);
+    for (const auto& observer : observers_) {
+        std::lock_guard<std::mutex> lock(observer->mutex);
+        ObserverDeliveryMetrics entry;
+        entry.observer = observer->name;
+        entry.mode = observer->mode;
+        entry.depth = observer->queue.size();
+        entry.maxDepth = observer->maxDepth;
+        entry.published = observer->published;
+        entry.delivered = observer->delivered;
+        entry.dropped = observer->dropped;
+        if (observer->delivered > 0) {
+            entry.avgLagMicros = static_cast<double>(observer->lagTotalNanos) /
+                                 static_cast<double>(observer->delivered) / 1000.0;
+        }
+        entry.maxLagMicros = static_cast<double>(observer->lagMaxNanos) / 1000.0;
+        metrics.push_back(entry);
+    }
+    return metrics;
+}
+
+namespace {
+
+// Stands in for a display that takes a while to redraw
+class SlowDisplay : public Observer {
+    std::chrono::milliseconds delay_;
+    std::atomic<float> lastTemperature_{0.0f};
+public:
+    explicit SlowDisplay(std::chrono::milliseconds delay) : delay_(delay) {}
+    void update(float temperature, float, float) override {
+        std::this_thread::sleep_for(delay_);
+        lastTemperature_ = temperature;
+    }
+    float getLastTemperature() const { return lastTemperature_.load(); }
+};
+
+class TallyDisplay : public Observer {
+    std::atomic<std::uint64_t> updates_{0};
+public:
+    void update(float, float, float) override { updates_.fetch_add(1, std::memory_order_relaxed); }
+    std::uint64_t getUpdates() const { return updates_.load(); }
+};
+
+}
+
+void demonstrateAsyncObservers() {
+    std::cout << "\n=== Async Observer Demo ===\n" << std::endl;
+
+    constexpr int kReadings = 200;
+    auto elapsedMicros = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    };
+
+    // Synchronous baseline: every setMeasurements waits for the slow display
+    {
+        WeatherStation station;
+        station.registerObserver(std::make_shared<SlowDisplay>(std::chrono::milliseconds(1)));
+        station.registerObserver(std::make_shared<TallyDisplay>());
+        auto start = Clock::now();
+        for (int i = 0; i < kReadings / 10; ++i) {
+            station.setMeasurements(20.0f + static_cast<float>(i) * 0.01f, 50.0f, 1013.0f);
+        }
+        std::cout << "Synchronous: " << elapsedMicros(start) / (kReadings / 10)
+                  << " us per setMeasurements" << std::endl;
+    }
+
+    WorkStealingPool pool(3);
+    AsyncNotifier notifier(pool, 256);
+    WeatherStation station;
+    auto queued = std::make_shared<SlowDisplay>(std::chrono::milliseconds(1));
+    auto conflated = std::make_shared<SlowDisplay>(std::chrono::milliseconds(1));
+    auto tally = std::make_shared<TallyDisplay>();
+    station.registerObserver(notifier.makeAsync(queued, "Queued slow display", DeliveryMode::Queue));
+    station.registerObserver(notifier.makeAsync(conflated, "Conflated slow display", DeliveryMode::Conflate));
+    station.registerObserver(notifier.makeAsync(tally, "Tally display"));
+
+    auto start = Clock::now();
+    for (int i = 0; i < kReadings; ++i) {
+        station.setMeasurements(20.0f + static_cast<float>(i) * 0.01f, 50.0f, 1013.0f);
+    }
+    std::cout << "Asynchronous: " << elapsedMicros(start) / kReadings
+              << " us per setMeasurements" << std::endl;
+    notifier.flush();
+
+    std::cout << "Conflated display ended on " << conflated->getLastTemperature() << "°C, tally saw "
+              << tally->getUpdates() << " of " << kReadings << " updates\n" << std::endl;
+
+    for (const auto& metrics : notifier.getMetrics()) {
+        std::cout << metrics.observer << ": published " << metrics.published
+                  << ", delivered " << metrics.delivered << ", dropped " << metrics.dropped
+                  << ", max depth " << metrics.maxDepth << ", avg lag " << metrics.avgLagMicros
+                  << " us, max lag " << metrics.maxLagMicros << " us" << std::endl;
+    }
+
+    std::cout << "\n=== End Async Observer Demo ===\n" << std::endl;
+}
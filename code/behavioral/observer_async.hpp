@@ -0,0 +1,80 @@
+#ifndef OBSERVER_ASYNC_HPP
+#define OBSERVER_ASYNC_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "observer.hpp"
+#include "work_stealing_pool.hpp"
+
+// How an asynchronous observer handles updates it has not consumed yet
+enum class DeliveryMode {
+    Queue,     // deliver every update in order; the oldest is dropped when full
+    Conflate   // keep only the latest update; older pending ones are dropped
+};
+
+// Snapshot of one asynchronous observer's counters
+struct ObserverDeliveryMetrics {
+    std::string observer;
+    DeliveryMode mode = DeliveryMode::Queue;
+    std::size_t depth = 0;
+    std::size_t maxDepth = 0;
+    std::uint64_t published = 0;
+    std::uint64_t delivered = 0;
+    std::uint64_t dropped = 0;
+    double avgLagMicros = 0.0;
+    double maxLagMicros = 0.0;
+};
+
+// Decouples slow observers from the subject.
+//
+// makeAsync wraps an observer in a proxy whose update() only records the
+// reading in that observer's own queue and submits a drain task to a
+// WorkStealingPool, so setMeasurements returns as soon as every proxy has
+// queued. Like a Strand, a queue has at most one drain task at a time, so
+// each observer still sees its updates in order and never concurrently.
+// Lag is measured from update() to the start of delivery.
+//
+// The notifier must outlive every subject its proxies are registered with,
+// and the pool must outlive the notifier.
+class AsyncNotifier {
+    class AsyncObserver;
+
+    WorkStealingPool& pool_;
+    std::vector<std::shared_ptr<AsyncObserver>> observers_;
+    mutable std::mutex observersMutex_;
+    std::size_t queueCapacity_;
+    // Updates queued and not yet delivered or dropped
+    std::atomic<std::uint64_t> pending_;
+
+public:
+    explicit AsyncNotifier(WorkStealingPool& pool, std::size_t queueCapacity = 1024);
+    // Waits for everything queued to be delivered
+    ~AsyncNotifier();
+
+    AsyncNotifier(const AsyncNotifier&) = delete;
+    AsyncNotifier& operator=(const AsyncNotifier&) = delete;
+
+    // Returns the proxy to register with a Subject in place of target
+    std::shared_ptr<Observer> makeAsync(std::shared_ptr<Observer> target, const std::string& name,
+                                        DeliveryMode mode = DeliveryMode::Queue);
+
+    // Blocks until every queued update has been delivered or dropped; not
+    // from a task on the pool, which could be the one it waits for
+    void flush();
+
+    std::vector<ObserverDeliveryMetrics> getMetrics() const;
+
+private:
+    void schedule(AsyncObserver& observer);
+    void drain(AsyncObserver& observer);
+    void completed(std::uint64_t count);
+};
+
+void demonstrateAsyncObservers();
+
+#endif // OBSERVER_ASYNC_HPP
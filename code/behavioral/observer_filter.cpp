@@ -0,0 +1,291 @@
+#include "observer_filter.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+ObserverHandle FilteredWeatherStation::registerObserver(std::shared_ptr<Observer> observer) {
+    return registerObserver(std::move(observer), ObserverFilter());
+}
+
+ObserverHandle FilteredWeatherStation::registerObserver(std::shared_ptr<Observer> observer,
+                                                        const ObserverFilter& filter) {
+    std::uint32_t index;
+    if (!freeSlots_.empty()) {
+        index = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    Slot& slot = slots_[index];
+    slot.dense = static_cast<std::uint32_t>(observers_.size());
+    slot.occupied = true;
+
+    bool ranged = false;
+    for (std::size_t field = 0; field < kFields; ++field) {
+        ranged |= filter.low[field] != -ObserverFilter::kUnbounded || filter.high[field] != ObserverFilter::kUnbounded;
+    }
+    rangedCount_ += ranged;
+
+    observers_.push_back(std::move(observer));
+    slotOf_.push_back(index);
+    ranged_.push_back(ranged);
+    for (std::size_t field = 0; field < kFields; ++field) {
+        deadband_[field].push_back(filter.deadband[field]);
+        low_[field].push_back(filter.low[field]);
+        high_[field].push_back(filter.high[field]);
+        // Infinitely far from any reading, so the first update always passes
+        lastDelivered_[field].push_back(ObserverFilter::kUnbounded);
+    }
+    return ObserverHandle{index, slot.generation};
+}
+
+bool FilteredWeatherStation::isCurrent(ObserverHandle handle) const {
+    return handle.index < slots_.size() && slots_[handle.index].occupied &&
+           slots_[handle.index].generation == handle.generation;
+}
+
+bool FilteredWeatherStation::removeObserver(ObserverHandle handle) {
+    if (!isCurrent(handle)) {
+        return false;
+    }
+    if (dispatching_) {
+        // Swapping entries now would make the dispatch loop skip one
+        deferredRemovals_.push_back(handle);
+        return true;
+    }
+    Slot& slot = slots_[handle.index];
+    eraseDense(slot.dense);
+    slot.occupied = false;
+    ++slot.generation;
+    freeSlots_.push_back(handle.index);
+    return true;
+}
+
+bool FilteredWeatherStation::removeObserver(const std::shared_ptr<Observer>& observer) {
+    for (std::size_t i = 0; i < observers_.size(); ++i) {
+        if (observers_[i] == observer) {
+            std::uint32_t index = slotOf_[i];
+            return removeObserver(ObserverHandle{index, slots_[index].generation});
+        }
+    }
+    return false;
+}
+
+void FilteredWeatherStation::eraseDense(std::size_t index) {
+    std::size_t last = observers_.size() - 1;
+    rangedCount_ -= ranged_[index];
+    if (index != last) {
+        observers_[index] = std::move(observers_[last]);
+        slotOf_[index] = slotOf_[last];
+        ranged_[index] = ranged_[last];
+        slots_[slotOf_[index]].dense = static_cast<std::uint32_t>(index);
+        for (std::size_t field = 0; field < kFields; ++field) {
+            deadband_[field][index] = deadband_[field][last];
+            low_[field][index] = low_[field][last];
+            high_[field][index] = high_[field][last];
+            lastDelivered_[field][index] = lastDelivered_[field][last];
+        }
+    }
+    observers_.pop_back();
+    slotOf_.pop_back();
+    ranged_.pop_back();
+    for (std::size_t field = 0; field < kFields; ++field) {
+        deadband_[field].pop_back();
+        low_[field].pop_back();
+        high_[field].pop_back();
+        lastDelivered_[field].pop_back();
+    }
+}
+
+// Fills masks_; range checks are compiled out while no filter uses them
+template<bool Ranged>
+void FilteredWeatherStation::evaluate() {
+    std::size_t count = observers_.size();
+    std::size_t blocks = (count + 3) / 4;
+    masks_.resize(blocks);
+
+    const float* low[kFields];
+    const float* high[kFields];
+    const float* last[kFields];
+    const float* deadband[kFields];
+    for (std::size_t field = 0; field < kFields; ++field) {
+        low[field] = low_[field].data();
+        high[field] = high_[field].data();
+        last[field] = lastDelivered_[field].data();
+        deadband[field] = deadband_[field].data();
+    }
+
+    std::size_t block = 0;
+#if defined(__SSE2__)
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    __m128 values[kFields];
+    for (std::size_t field = 0; field < kFields; ++field) {
+        values[field] = _mm_set1_ps(current_[field]);
+    }
+    for (; block < count / 4; ++block) {
+        std::size_t first = block * 4;
+        __m128 inRange = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        __m128 moved = _mm_setzero_ps();
+        for (std::size_t field = 0; field < kFields; ++field) {
+            if constexpr (Ranged) {
+                __m128 lowest = _mm_loadu_ps(low[field] + first);
+                __m128 highest = _mm_loadu_ps(high[field] + first);
+                inRange = _mm_and_ps(inRange, _mm_and_ps(_mm_cmpge_ps(values[field], lowest),
+                                                         _mm_cmple_ps(values[field], highest)));
+            }
+            __m128 change = _mm_andnot_ps(signBit, _mm_sub_ps(values[field], _mm_loadu_ps(last[field] + first)));
+            moved = _mm_or_ps(moved, _mm_cmpge_ps(change, _mm_loadu_ps(deadband[field] + first)));
+        }
+        masks_[block] = static_cast<std::uint8_t>(_mm_movemask_ps(_mm_and_ps(inRange, moved)));
+    }
+#endif
+    for (; block < blocks; ++block) {
+        std::uint8_t mask = 0;
+        for (std::size_t i = block * 4; i < std::min(count, block * 4 + 4); ++i) {
+            bool inRange = true;
+            bool moved = false;
+            for (std::size_t field = 0; field < kFields; ++field) {
+                float value = current_[field];
+                if constexpr (Ranged) {
+                    inRange &= value >= low[field][i] && value <= high[field][i];
+                }
+                moved |= std::fabs(value - last[field][i]) >= deadband[field][i];
+            }
+            mask |= static_cast<std::uint8_t>((inRange && moved) << (i - block * 4));
+        }
+        masks_[block] = mask;
+    }
+}
+
+void FilteredWeatherStation::notifyObservers() {
+    // Filter pass over all observers before any virtual call
+    if (rangedCount_ > 0) {
+        evaluate<true>();
+    } else {
+        evaluate<false>();
+    }
+    std::size_t count = observers_.size();
+    std::size_t blocks = masks_.size();
+
+    // Dispatch pass: whole blocks of rejected observers are skipped at once
+    dispatching_ = true;
+    std::uint64_t dispatched = 0;
+    for (std::size_t block = 0; block < blocks; ++block) {
+        for (unsigned mask = masks_[block]; mask != 0; mask &= mask - 1) {
+            std::size_t i = block * 4 + static_cast<std::size_t>(std::countr_zero(mask));
+            for (std::size_t field = 0; field < kFields; ++field) {
+                lastDelivered_[field][i] = current_[field];
+            }
+            observers_[i]->update(current_[0], current_[1], current_[2]);
+            ++dispatched;
+        }
+    }
+    dispatching_ = false;
+    dispatched_ += dispatched;
+    avoided_ += count - dispatched;
+
+    std::vector<ObserverHandle> removals;
+    removals.swap(deferredRemovals_);
+    for (auto handle : removals) {
+        removeObserver(handle);
+    }
+}
+
+void FilteredWeatherStation::setMeasurements(float temperature, float humidity, float pressure) {
+    current_ = {temperature, humidity, pressure};
+    notifyObservers();
+}
+
+namespace {
+
+class UpdateCounter : public Observer {
+    std::uint64_t updates_ = 0;
+public:
+    void update(float, float, float) override { ++updates_; }
+    std::uint64_t getUpdates() const { return updates_; }
+};
+
+// Does a little real work per update: the Magnus dew point approximation
+class DewPointMonitor : public Observer {
+    float dewPoint_ = 0.0f;
+public:
+    void update(float temperature, float humidity, float) override {
+        float gamma = std::log(std::max(humidity, 1.0f) / 100.0f) + 17.62f * temperature / (243.12f + temperature);
+        dewPoint_ = 243.12f * gamma / (17.62f - gamma);
+    }
+    float getDewPoint() const { return dewPoint_; }
+};
+
+}
+
+void demonstrateFilteredObservers() {
+    std::cout << "\n=== Filtered Observer Demo ===\n" << std::endl;
+
+    FilteredWeatherStation station;
+
+    // A display that only cares about temperature moves of half a degree
+    auto thermometer = std::make_shared<CurrentConditionsDisplay>("Thermometer");
+    station.registerObserver(thermometer, ObserverFilter().watch(ReadingField::Temperature, 0.5f));
+    // An alarm that only fires below 1000 hPa
+    auto stormAlarm = std::make_shared<UpdateCounter>();
+    station.registerObserver(stormAlarm, ObserverFilter().inRange(ReadingField::Pressure, 0.0f, 1000.0f));
+
+    station.setMeasurements(20.0f, 60.0f, 1013.0f);
+    station.setMeasurements(20.2f, 61.0f, 1012.0f);   // below the deadband
+    station.setMeasurements(20.6f, 62.0f, 1008.0f);   // temperature moved 0.6
+    station.setMeasurements(20.7f, 70.0f, 998.0f);    // storm
+    std::cout << "Storm alarm fired " << stormAlarm->getUpdates() << " time(s); "
+              << station.getDispatchCount() << " dispatches, " << station.getAvoidedCount()
+              << " avoided\n" << std::endl;
+
+    // Many observers with assorted deadbands on a slow random walk
+    constexpr std::size_t kObservers = 100'000;
+    constexpr int kUpdates = 200;
+    FilteredWeatherStation filtered;
+    WeatherStation plain;
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> band(0.1f, 2.0f);
+    for (std::size_t i = 0; i < kObservers; ++i) {
+        auto monitor = std::make_shared<DewPointMonitor>();
+        auto field = static_cast<ReadingField>(i % 3);
+        filtered.registerObserver(monitor, ObserverFilter().watch(field, band(random)));
+        plain.registerObserver(monitor);
+    }
+
+    std::normal_distribution<float> step(0.0f, 0.1f);
+    std::vector<std::array<float, 3>> readings;
+    std::array<float, 3> reading{20.0f, 60.0f, 1013.0f};
+    for (int i = 0; i < kUpdates; ++i) {
+        for (auto& value : reading) {
+            value += step(random);
+        }
+        readings.push_back(reading);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    for (const auto& r : readings) {
+        plain.setMeasurements(r[0], r[1], r[2]);
+    }
+    double plainMicros = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / kUpdates;
+    start = Clock::now();
+    for (const auto& r : readings) {
+        filtered.setMeasurements(r[0], r[1], r[2]);
+    }
+    double filteredMicros = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / kUpdates;
+
+    std::cout << kObservers << " observers, " << kUpdates << " updates:" << std::endl;
+    std::cout << "  Unfiltered: " << plainMicros << " us per update" << std::endl;
+    std::cout << "  Filtered: " << filteredMicros << " us per update, " << filtered.getDispatchCount()
+              << " dispatches, " << filtered.getAvoidedCount() << " avoided" << std::endl;
+
+    std::cout << "\n=== End Filtered Observer Demo ===\n" << std::endl;
+}
@@ -0,0 +1,105 @@
+#ifndef OBSERVER_FILTER_HPP
+#define OBSERVER_FILTER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "observer.hpp"
+
+// Declarative description of which updates an observer wants.
+//
+// An update is delivered when every field lies inside its range and at least
+// one watched field has moved by its deadband or more since the last update
+// delivered to this observer. The default filter watches every field with a
+// zero deadband, i.e. it passes everything. The first update always passes.
+struct ObserverFilter {
+    static constexpr float kUnbounded = std::numeric_limits<float>::infinity();
+
+    std::array<float, TimeSeriesStore::kFieldCount> deadband{0.0f, 0.0f, 0.0f};
+    std::array<float, TimeSeriesStore::kFieldCount> low{-kUnbounded, -kUnbounded, -kUnbounded};
+    std::array<float, TimeSeriesStore::kFieldCount> high{kUnbounded, kUnbounded, kUnbounded};
+    bool watchesAll = true;
+
+    // Only changes to watched fields count; the first watch() replaces "all"
+    ObserverFilter& watch(ReadingField field, float minimumChange = 0.0f) {
+        if (watchesAll) {
+            deadband.fill(kUnbounded);
+            watchesAll = false;
+        }
+        deadband[static_cast<std::size_t>(field)] = minimumChange;
+        return *this;
+    }
+
+    ObserverFilter& inRange(ReadingField field, float lowest, float highest) {
+        low[static_cast<std::size_t>(field)] = lowest;
+        high[static_cast<std::size_t>(field)] = highest;
+        return *this;
+    }
+};
+
+// Concrete Subject: weather station that filters before it dispatches.
+//
+// Filters are kept as columns (one array per field for deadbands, bounds and
+// last delivered values), so each notification first runs one branch-free
+// SIMD pass that evaluates four observers' filters at a time into a bit
+// mask, and only then makes virtual update() calls for the set bits. Observers
+// are kept dense with swap-and-pop removal through generational handles.
+// Unlike WeatherStation this subject is single-threaded; observers may
+// register or unregister from inside update().
+class FilteredWeatherStation : public Subject {
+    static constexpr std::size_t kFields = TimeSeriesStore::kFieldCount;
+
+    struct Slot {
+        std::uint32_t generation = 0;
+        std::uint32_t dense = 0;
+        bool occupied = false;
+    };
+
+    // Dense, index-aligned columns
+    std::vector<std::shared_ptr<Observer>> observers_;
+    std::vector<std::uint32_t> slotOf_;
+    std::vector<std::uint8_t> ranged_;
+    std::array<std::vector<float>, kFields> deadband_;
+    std::array<std::vector<float>, kFields> low_;
+    std::array<std::vector<float>, kFields> high_;
+    std::array<std::vector<float>, kFields> lastDelivered_;
+    // Pass bits for each block of four observers
+    std::vector<std::uint8_t> masks_;
+
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> freeSlots_;
+    std::vector<ObserverHandle> deferredRemovals_;
+    std::size_t rangedCount_ = 0;
+    bool dispatching_ = false;
+
+    std::array<float, kFields> current_{0.0f, 0.0f, 0.0f};
+    std::uint64_t dispatched_ = 0;
+    std::uint64_t avoided_ = 0;
+
+public:
+    ObserverHandle registerObserver(std::shared_ptr<Observer> observer) override;
+    ObserverHandle registerObserver(std::shared_ptr<Observer> observer, const ObserverFilter& filter);
+    bool removeObserver(ObserverHandle handle) override;
+    bool removeObserver(const std::shared_ptr<Observer>& observer) override;
+    void notifyObservers() override;
+
+    void setMeasurements(float temperature, float humidity, float pressure);
+
+    std::size_t getObserverCount() const { return observers_.size(); }
+    std::uint64_t getDispatchCount() const { return dispatched_; }
+    // Update calls skipped because the observer's filter rejected them
+    std::uint64_t getAvoidedCount() const { return avoided_; }
+
+private:
+    bool isCurrent(ObserverHandle handle) const;
+    template<bool Ranged>
+    void evaluate();
+    void eraseDense(std::size_t index);
+};
+
+void demonstrateFilteredObservers();
+
+#endif // OBSERVER_FILTER_HPP
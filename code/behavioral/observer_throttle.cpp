@@ -0,0 +1,289 @@
+#include "observer_throttle.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+
+namespace {
+
+struct Reading {
+    float temperature = 0.0f;
+    float humidity = 0.0f;
+    float pressure = 0.0f;
+};
+
+}
+
+// Proxy observer: the latest undelivered reading and its window state
+class NotificationThrottle::ThrottledObserver
+    : public Observer, public std::enable_shared_from_this<ThrottledObserver> {
+public:
+    NotificationThrottle& throttle;
+    std::shared_ptr<Observer> target;
+    std::string name;
+    ThrottlePolicy policy;
+
+    std::mutex mutex;
+    Reading latest;
+    std::uint64_t latestSequence = 0;
+    bool pending = false;
+    bool armed = false;
+    Clock::time_point nextAllowed = Clock::time_point::min();
+    Clock::time_point lastUpdate = Clock::time_point::min();
+    std::uint64_t published = 0;
+    std::uint64_t delivered = 0;
+    std::uint64_t suppressed = 0;
+
+    // Held while the target runs; orders leading and trailing deliveries
+    std::mutex deliveryMutex;
+    std::uint64_t deliveredSequence = 0;
+
+    ThrottledObserver(NotificationThrottle& owner, std::shared_ptr<Observer> observer, std::string observerName,
+                      const ThrottlePolicy& throttlePolicy)
+        : throttle(owner), target(std::move(observer)), name(std::move(observerName)), policy(throttlePolicy) {}
+
+    void update(float temperature, float humidity, float pressure) override {
+        Clock::time_point now = Clock::now();
+        Reading reading{temperature, humidity, pressure};
+        std::uint64_t sequence;
+        bool deliverNow = false;
+        bool armTimer = false;
+        Clock::time_point deadline;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sequence = ++published;
+            Clock::time_point earliest = std::max(nextAllowed, lastUpdate + policy.quietPeriod);
+            lastUpdate = now;
+            if (policy.leading && !pending && !armed && now >= earliest) {
+                deliverNow = true;
+                nextAllowed = now + policy.minInterval;
+            } else if (policy.trailing) {
+                suppressed += pending;
+                latest = reading;
+                latestSequence = sequence;
+                pending = true;
+                if (!armed) {
+                    armed = armTimer = true;
+                    // Without a leading edge the window opens with this update
+                    Clock::time_point opened = policy.leading ? now : now + policy.minInterval;
+                    deadline = std::max({nextAllowed, now + policy.quietPeriod, opened});
+                }
+            } else {
+                ++suppressed;
+            }
+        }
+
+        if (deliverNow) {
+            deliver(reading, sequence);
+        }
+        if (armTimer) {
+            throttle.arm(shared_from_this(), deadline);
+        }
+    }
+
+    // Called by the wheel once the armed deadline has passed
+    void fire() {
+        Clock::time_point now = Clock::now();
+        Reading reading;
+        std::uint64_t sequence;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!pending) {
+                armed = false;
+                return;
+            }
+            // Updates since arming may have pushed the debounce back
+            Clock::time_point due = std::max(nextAllowed, lastUpdate + policy.quietPeriod);
+            if (now < due) {
+                throttle.arm(shared_from_this(), due);
+                return;
+            }
+            reading = latest;
+            sequence = latestSequence;
+            pending = false;
+            armed = false;
+            nextAllowed = now + policy.minInterval;
+        }
+        deliver(reading, sequence);
+    }
+
+private:
+    void deliver(const Reading& reading, std::uint64_t sequence) {
+        std::lock_guard<std::mutex> deliveryLock(deliveryMutex);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (sequence <= deliveredSequence) {
+                // Overtaken by a newer reading that was delivered first
+                ++suppressed;
+                return;
+            }
+            deliveredSequence = sequence;
+            ++delivered;
+        }
+        target->update(reading.temperature, reading.humidity, reading.pressure);
+    }
+};
+
+NotificationThrottle::NotificationThrottle(std::chrono::nanoseconds tick)
+    : tick_(std::max(tick, std::chrono::nanoseconds(std::chrono::microseconds(10)))),
+      epoch_(Clock::now()), wheel_(kWheelSlots), currentTick_(0), armed_(0), stopping_(false) {
+    thread_ = std::thread([this]() { run(); });
+}
+
+NotificationThrottle::~NotificationThrottle() {
+    {
+        std::lock_guard<std::mutex> lock(wheelMutex_);
+        stopping_ = true;
+    }
+    wheelCondition_.notify_all();
+    thread_.join();
+}
+
+std::shared_ptr<Observer> NotificationThrottle::makeThrottled(std::shared_ptr<Observer> target,
+                                                              const std::string& name,
+                                                              const ThrottlePolicy& policy) {
+    auto observer = std::make_shared<ThrottledObserver>(*this, std::move(target), name, policy);
+    std::lock_guard<std::mutex> lock(observersMutex_);
+    std::erase_if(observers_, [](const std::weak_ptr<ThrottledObserver>& entry) { return entry.expired(); });
+    observers_.push_back(observer);
+    return observer;
+}
+
+std::uint64_t NotificationThrottle::tickAt(Clock::time_point time) const {
+    return static_cast<std::uint64_t>((time - epoch_) / tick_);
+}
+
+void NotificationThrottle::arm(std::shared_ptr<ThrottledObserver> observer, Clock::time_point deadline) {
+    // First tick that starts at or after the deadline
+    auto sinceEpoch = std::max(deadline - epoch_, Clock::duration::zero());
+    auto target = static_cast<std::uint64_t>((sinceEpoch + tick_ - std::chrono::nanoseconds(1)) / tick_);
+
+    std::lock_guard<std::mutex> lock(wheelMutex_);
+    if (armed_ == 0) {
+        // The wheel stops turning while empty; skip the idle ticks
+        currentTick_ = std::max(currentTick_, tickAt(Clock::now()));
+    }
+    target = std::max(target, currentTick_ + 1);
+    std::uint64_t distance = target - currentTick_;
+    wheel_[target % kWheelSlots].push_back(Timer{std::move(observer), (distance - 1) / kWheelSlots});
+    if (armed_++ == 0) {
+        wheelCondition_.notify_one();
+    }
+}
+
+void NotificationThrottle::run() {
+    std::vector<Timer> due;
+    std::unique_lock<std::mutex> lock(wheelMutex_);
+    while (!stopping_) {
+        if (armed_ == 0) {
+            wheelCondition_.wait(lock, [this]() { return stopping_ || armed_ > 0; });
+            continue;
+        }
+        wheelCondition_.wait_until(lock, epoch_ + tick_ * (currentTick_ + 1));
+
+        std::uint64_t now = tickAt(Clock::now());
+        while (currentTick_ < now && !stopping_) {
+            ++currentTick_;
+            auto& bucket = wheel_[currentTick_ % kWheelSlots];
+            due.clear();
+            std::size_t kept = 0;
+            for (Timer& timer : bucket) {
+                if (timer.rounds == 0) {
+                    due.push_back(std::move(timer));
+                } else {
+                    --timer.rounds;
+                    if (&bucket[kept++] != &timer) {
+                        bucket[kept - 1] = std::move(timer);
+                    }
+                }
+            }
+            bucket.resize(kept);
+            armed_ -= due.size();
+
+            if (!due.empty()) {
+                // Firing may re-arm, which takes the wheel lock
+                lock.unlock();
+                for (const Timer& timer : due) {
+                    timer.observer->fire();
+                }
+                // May release the last reference to a removed proxy
+                due.clear();
+                lock.lock();
+            }
+        }
+    }
+}
+
+std::vector<ThrottleMetrics> NotificationThrottle::getMetrics() const {
+    std::vector<ThrottleMetrics> metrics;
+    std::lock_guard<std::mutex> observersLock(observersMutex_);
+    for (const auto& entry : observers_) {
+        auto observer = entry.lock();
+        if (!observer) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(observer->mutex);
+        metrics.push_back(ThrottleMetrics{observer->name, observer->published, observer->delivered,
+                                          observer->suppressed});
+    }
+    return metrics;
+}
+
+std::size_t NotificationThrottle::getArmedCount() const {
+    std::lock_guard<std::mutex> lock(wheelMutex_);
+    return armed_;
+}
+
+namespace {
+
+// Remembers the latest temperature it was given; read from another thread
+class LatestTemperature : public Observer {
+    std::atomic<float> temperature_{0.0f};
+public:
+    void update(float temperature, float, float) override {
+        temperature_.store(temperature, std::memory_order_relaxed);
+    }
+    float getTemperature() const { return temperature_.load(std::memory_order_relaxed); }
+};
+
+}
+
+void demonstrateThrottledObservers() {
+    std::cout << "\n=== Throttled Observer Demo ===\n" << std::endl;
+
+    using namespace std::chrono_literals;
+    NotificationThrottle throttle;
+    WeatherStation station;
+
+    auto panel = std::make_shared<LatestTemperature>();
+    auto settled = std::make_shared<LatestTemperature>();
+    auto ticker = std::make_shared<LatestTemperature>();
+    station.registerObserver(throttle.makeThrottled(panel, "Panel (10 Hz)", ThrottlePolicy::maxRate(10.0)));
+    station.registerObserver(throttle.makeThrottled(settled, "Settled (50 ms debounce)",
+                                                    ThrottlePolicy::debounce(50ms)));
+    station.registerObserver(throttle.makeThrottled(ticker, "Ticker (10 Hz, leading only)",
+                                                    ThrottlePolicy::maxRate(10.0, false)));
+
+    // Two bursts from a 10 kHz sensor, 250 ms each, with a pause between them
+    float temperature = 20.0f;
+    auto next = std::chrono::steady_clock::now();
+    for (int burst = 0; burst < 2; ++burst) {
+        for (int i = 0; i < 2'500; ++i) {
+            temperature += 0.001f;
+            station.setMeasurements(temperature, 50.0f, 1013.0f);
+            next += 100us;
+            std::this_thread::sleep_until(next);
+        }
+        next += 150ms;
+        std::this_thread::sleep_until(next);
+    }
+
+    for (const auto& metrics : throttle.getMetrics()) {
+        std::cout << metrics.observer << ": " << metrics.published << " published, " << metrics.delivered
+                  << " delivered, " << metrics.suppressed << " suppressed" << std::endl;
+    }
+    std::cout << "Final reading " << temperature << "°C; panel shows " << panel->getTemperature()
+              << "°C, settled shows " << settled->getTemperature() << "°C, ticker shows "
+              << ticker->getTemperature() << "°C" << std::endl;
+
+    std::cout << "\n=== End Throttled Observer Demo ===\n" << std::endl;
+}
@@ -0,0 +1,125 @@
+#ifndef OBSERVER_THROTTLE_HPP
+#define OBSERVER_THROTTLE_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "observer.hpp"
+
+// When a throttled observer may be updated.
+//
+// An update is delivered no sooner than minInterval after the previous
+// delivery and no sooner than quietPeriod after the latest update (the
+// debounce). Updates that arrive in between are conflated: only the latest
+// one is kept, and with trailing it is delivered once the window closes.
+// With leading, an update that arrives while no window is open is delivered
+// at once instead of waiting.
+struct ThrottlePolicy {
+    std::chrono::nanoseconds minInterval{0};
+    std::chrono::nanoseconds quietPeriod{0};
+    bool leading = true;
+    bool trailing = true;
+
+    // At most hertz deliveries per second; hertz must be positive
+    static ThrottlePolicy maxRate(double hertz, bool trailing = true) {
+        if (!(hertz > 0.0)) {
+            throw std::invalid_argument("ThrottlePolicy: rate must be positive");
+        }
+        ThrottlePolicy policy;
+        policy.minInterval = std::chrono::nanoseconds(static_cast<std::int64_t>(1e9 / hertz));
+        policy.trailing = trailing;
+        return policy;
+    }
+
+    // Only the latest update of each burst, once the feed has been quiet for quiet
+    static ThrottlePolicy debounce(std::chrono::nanoseconds quiet) {
+        ThrottlePolicy policy;
+        policy.quietPeriod = quiet;
+        policy.leading = false;
+        return policy;
+    }
+};
+
+// Snapshot of one throttled observer's counters
+struct ThrottleMetrics {
+    std::string observer;
+    std::uint64_t published = 0;
+    std::uint64_t delivered = 0;
+    std::uint64_t suppressed = 0;  // conflated into a later update or dropped
+};
+
+// Enforces ThrottlePolicy for any number of observers from one timer wheel.
+//
+// makeThrottled wraps an observer in a proxy. Leading deliveries happen on
+// the publishing thread, inside update(); trailing ones happen on the wheel's
+// thread. Either way a target sees its updates one at a time and never an
+// older reading after a newer one. A proxy in a burst costs one lock per
+// update and at most one armed timer: a debounce that gets pushed back is
+// re-armed lazily when its timer fires, not on every update.
+//
+// The wheel has kWheelSlots buckets of one tick each. A timer further out
+// than one revolution waits in its bucket for the remaining rounds. The
+// wheel's thread sleeps while no timer is armed.
+//
+// The throttle does not own its proxies: a proxy lives as long as the
+// subject holds it, plus while one of its timers is armed so a pending
+// trailing update is still delivered after it has been removed. Metrics are
+// only reported for proxies that are still alive.
+//
+// The throttle must outlive every subject its proxies are registered with;
+// trailing updates still pending when it is destroyed are dropped.
+class NotificationThrottle {
+    class ThrottledObserver;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t kWheelSlots = 512;
+
+    struct Timer {
+        std::shared_ptr<ThrottledObserver> observer;
+        std::uint64_t rounds;
+    };
+
+    std::vector<std::weak_ptr<ThrottledObserver>> observers_;
+    mutable std::mutex observersMutex_;
+
+    std::chrono::nanoseconds tick_;
+    Clock::time_point epoch_;
+    std::vector<std::vector<Timer>> wheel_;
+    std::uint64_t currentTick_;
+    std::size_t armed_;
+    mutable std::mutex wheelMutex_;
+    std::condition_variable wheelCondition_;
+    bool stopping_;
+    std::thread thread_;
+
+public:
+    explicit NotificationThrottle(std::chrono::nanoseconds tick = std::chrono::milliseconds(1));
+    ~NotificationThrottle();
+
+    NotificationThrottle(const NotificationThrottle&) = delete;
+    NotificationThrottle& operator=(const NotificationThrottle&) = delete;
+
+    // Returns the proxy to register with a Subject in place of target
+    std::shared_ptr<Observer> makeThrottled(std::shared_ptr<Observer> target, const std::string& name,
+                                            const ThrottlePolicy& policy);
+
+    std::vector<ThrottleMetrics> getMetrics() const;
+    // Timers currently in the wheel
+    std::size_t getArmedCount() const;
+
+private:
+    std::uint64_t tickAt(Clock::time_point time) const;
+    void arm(std::shared_ptr<ThrottledObserver> observer, Clock::time_point deadline);
+    void run();
+};
+
+void demonstrateThrottledObservers();
+
+#endif // OBSERVER_THROTTLE_HPP
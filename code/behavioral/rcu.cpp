@@ -0,0 +1,139 @@
+#include "rcu.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+// Per-thread reader state: the claimed slot and the read-section nesting depth
+struct EpochThreadRecord {
+    EpochDomain::Slot* slot = nullptr;
+    unsigned depth = 0;
+
+    ~EpochThreadRecord() {
+        if (slot != nullptr) {
+            slot->epoch.store(0, std::memory_order_release);
+            slot->claimed.store(false, std::memory_order_release);
+        }
+    }
+};
+
+namespace {
+thread_local EpochThreadRecord threadRecord;
+}
+
+EpochDomain& EpochDomain::instance() {
+    static EpochDomain domain;
+    return domain;
+}
+
+EpochDomain::ReadGuard::ReadGuard() {
+    EpochThreadRecord& record = threadRecord;
+    if (record.depth++ > 0) {
+        // The outermost guard's epoch already protects everything we can see
+        return;
+    }
+    EpochDomain& domain = instance();
+    if (record.slot == nullptr) {
+        record.slot = &domain.claimSlot();
+    }
+    // Sequentially consistent so the announcement is ordered before the
+    // reader's load of any published pointer
+    record.slot->epoch.store(domain.epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+}
+
+EpochDomain::ReadGuard::~ReadGuard() {
+    EpochThreadRecord& record = threadRecord;
+    if (--record.depth == 0) {
+        record.slot->epoch.store(0, std::memory_order_release);
+    }
+}
+
+EpochDomain::Pin::Pin() {
+    EpochDomain& domain = instance();
+    // Registered under the same lock reclaim() scans with, so a reclaim
+    // either sees this pin or ran before it and freed only older versions
+    std::lock_guard<std::mutex> lock(domain.retiredMutex_);
+    epoch_ = domain.epoch_.load(std::memory_order_seq_cst);
+    domain.pins_.push_back(epoch_);
+}
+
+EpochDomain::Pin::~Pin() {
+    EpochDomain& domain = instance();
+    {
+        std::lock_guard<std::mutex> lock(domain.retiredMutex_);
+        auto it = std::find(domain.pins_.begin(), domain.pins_.end(), epoch_);
+        *it = domain.pins_.back();
+        domain.pins_.pop_back();
+    }
+    domain.reclaim();
+}
+
+EpochDomain::~EpochDomain() {
+    for (auto& retired : retired_) {
+        retired.free();
+    }
+}
+
+EpochDomain::Slot& EpochDomain::claimSlot() {
+    for (auto& slot : slots_) {
+        bool expected = false;
+        if (!slot.claimed.load(std::memory_order_relaxed) &&
+            slot.claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return slot;
+        }
+    }
+    throw std::runtime_error("EpochDomain: too many concurrent reader threads");
+}
+
+void EpochDomain::retire(std::function<void()> free) {
+    // The caller has already swapped the old version out, so any reader that
+    // announces the advanced epoch is guaranteed to see the new one
+    std::uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst);
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex_);
+        retired_.push_back(Retired{epoch, std::move(free)});
+    }
+    reclaim();
+}
+
+std::uint64_t EpochDomain::oldestActiveEpoch() const {
+    std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+    for (const auto& slot : slots_) {
+        std::uint64_t epoch = slot.epoch.load(std::memory_order_seq_cst);
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+    for (std::uint64_t epoch : pins_) {
+        oldest = std::min(oldest, epoch);
+    }
+    return oldest;
+}
+
+void EpochDomain::reclaim() {
+    std::vector<Retired> ready;
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex_);
+        if (retired_.empty()) {
+            return;
+        }
+        std::uint64_t oldest = oldestActiveEpoch();
+        std::size_t kept = 0;
+        for (auto& retired : retired_) {
+            if (retired.epoch < oldest) {
+                ready.push_back(std::move(retired));
+            } else if (&retired_[kept++] != &retired) {
+                retired_[kept - 1] = std::move(retired);
+            }
+        }
+        retired_.resize(kept);
+    }
+    // Outside the lock: freeing can release observers that retire in turn
+    for (auto& retired : ready) {
+        retired.free();
+    }
+}
+
+std::size_t EpochDomain::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(retiredMutex_);
+    return retired_.size();
+}
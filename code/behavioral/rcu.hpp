@@ -0,0 +1,349 @@
+#ifndef RCU_HPP
+#define RCU_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Epoch-based reclamation for read-copy-update structures.
+//
+// Readers announce the global epoch in a per-thread slot for the duration of
+// a ReadGuard; entering and leaving are a load and two stores, so readers
+// never wait on anything. Writers publish a new version, advance the epoch
+// and retire the old version tagged with the epoch it was current in. A
+// retired version is freed once no slot announces an epoch at or below its
+// tag, i.e. once every reader that could still see it has left.
+//
+// Read sections may nest and may call into writers (an observer that
+// unsubscribes itself from inside update() is fine).
+class EpochDomain {
+public:
+    static constexpr std::size_t kMaxThreads = 256;
+
+    // Process-wide domain shared by every RCU structure
+    static EpochDomain& instance();
+
+    class ReadGuard {
+    public:
+        ReadGuard();
+        ~ReadGuard();
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+
+    // A read section that is not tied to a thread: it can be handed to other
+    // threads and released from any of them. Costs a lock, unlike ReadGuard.
+    class Pin {
+        std::uint64_t epoch_;
+    public:
+        Pin();
+        ~Pin();
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+    };
+
+    EpochDomain() = default;
+    ~EpochDomain();
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // Call after unpublishing a version; free runs once no reader can see it
+    void retire(std::function<void()> free);
+    // Frees whatever has become unreachable; retire() calls this too
+    void reclaim();
+
+    std::size_t getPendingCount() const;
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> epoch{0};  // 0 = not reading
+        std::atomic<bool> claimed{false};
+    };
+
+    struct Retired {
+        std::uint64_t epoch;
+        std::function<void()> free;
+    };
+
+    std::array<Slot, kMaxThreads> slots_;
+    std::atomic<std::uint64_t> epoch_{1};
+    mutable std::mutex retiredMutex_;
+    std::vector<Retired> retired_;
+    std::vector<std::uint64_t> pins_;  // guarded by retiredMutex_
+
+    friend struct EpochThreadRecord;
+    Slot& claimSlot();
+    std::uint64_t oldestActiveEpoch() const;
+};
+
+// Generational index into an RcuSlotMap. A handle goes stale when its element
+// is erased; stale handles are rejected even after the slot is reused.
+struct SlotHandle {
+    std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t generation = 0;
+
+    bool isValid() const { return index != std::numeric_limits<std::uint32_t>::max(); }
+};
+
+// Slot map with wait-free traversal and O(1) insert/erase by handle.
+//
+// Elements live in a dense array that forEach walks front to back, skipping
+// the few erased ones. The array has spare capacity past its published count:
+// insert writes the next free entry and then bumps the count, and erase just
+// clears the entry's live flag, so neither disturbs a traversal in progress.
+// Once erased entries outnumber live ones, or capacity runs out, the live
+// entries are compacted into a new array that is published with one pointer
+// swap while the old one is retired through the EpochDomain. That keeps both
+// operations amortized O(1). Erased elements stay alive until their array is
+// reclaimed. Writers serialize on a mutex.
+//
+// Retired arrays stay linked to the array that replaced them until they are
+// reclaimed, and each entry remembers where it was in the array before, so an
+// erase also clears the element in any older array a view still pins.
+template<typename T>
+class RcuSlotMap {
+    static constexpr std::uint32_t kNoEntry = std::numeric_limits<std::uint32_t>::max();
+
+    struct Entry {
+        T value{};
+        std::uint32_t slot = 0;
+        // Position in the array this one replaced, if the entry was there
+        std::uint32_t formerDense = kNoEntry;
+        std::atomic<bool> live{false};
+    };
+
+    struct Table {
+        std::unique_ptr<Entry[]> entries;
+        std::size_t capacity;
+        std::atomic<std::size_t> count{0};
+        // Neighbours not yet reclaimed; guarded by History::mutex
+        Table* previous = nullptr;
+        Table* next = nullptr;
+        explicit Table(std::size_t size) : entries(new Entry[size]), capacity(size) {}
+    };
+
+    // Shared with the reclaim callbacks, which may run after the map is gone
+    struct History {
+        std::mutex mutex;
+    };
+
+    struct Slot {
+        std::uint32_t generation = 0;
+        std::uint32_t dense = 0;
+        bool occupied = false;
+    };
+
+    static constexpr std::size_t kMinCapacity = 16;
+    static constexpr std::size_t kMinCompaction = 64;
+
+    std::atomic<Table*> current_;
+    mutable std::mutex writerMutex_;
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> freeSlots_;
+    std::atomic<std::size_t> live_;
+    std::shared_ptr<History> history_;
+
+public:
+    RcuSlotMap() : current_(new Table(kMinCapacity)), live_(0), history_(std::make_shared<History>()) {}
+
+    // The array is retired rather than freed, so views and traversals still
+    // in progress keep it alive until they finish
+    ~RcuSlotMap() {
+        retire(current_.load(std::memory_order_relaxed));
+    }
+
+    RcuSlotMap(const RcuSlotMap&) = delete;
+    RcuSlotMap& operator=(const RcuSlotMap&) = delete;
+
+    SlotHandle insert(T value) {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        Table* table = current_.load(std::memory_order_relaxed);
+        if (table->count.load(std::memory_order_relaxed) == table->capacity) {
+            table = rebuild(std::max(kMinCapacity, live_.load(std::memory_order_relaxed) * 2));
+        }
+
+        std::uint32_t index;
+        if (!freeSlots_.empty()) {
+            index = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+
+        std::size_t dense = table->count.load(std::memory_order_relaxed);
+        Entry& entry = table->entries[dense];
+        entry.value = std::move(value);
+        entry.slot = index;
+        entry.live.store(true, std::memory_order_relaxed);
+        table->count.store(dense + 1, std::memory_order_release);
+
+        Slot& slot = slots_[index];
+        slot.dense = static_cast<std::uint32_t>(dense);
+        slot.occupied = true;
+        live_.fetch_add(1, std::memory_order_relaxed);
+        return SlotHandle{index, slot.generation};
+    }
+
+    // Returns false for stale or invalid handles
+    bool erase(SlotHandle handle) {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        return eraseLocked(handle);
+    }
+
+    // Erases the first live element matching the predicate; linear, prefer handles
+    template<typename Predicate>
+    bool eraseFirstIf(Predicate matches) {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        Table* table = current_.load(std::memory_order_relaxed);
+        std::size_t count = table->count.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            Entry& entry = table->entries[i];
+            if (entry.live.load(std::memory_order_relaxed) && matches(entry.value)) {
+                return eraseLocked(SlotHandle{entry.slot, slots_[entry.slot].generation});
+            }
+        }
+        return false;
+    }
+
+    bool contains(SlotHandle handle) const {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        return isCurrent(handle);
+    }
+
+    // Pinned view of the dense array as it was when the view was taken. It
+    // may be shared across threads; erasures made later are still honoured,
+    // even after the map has moved to a new array. It may outlive the map.
+    class View {
+        EpochDomain::Pin pin_;
+        const Table* table_;
+        std::size_t count_;
+    public:
+        explicit View(const RcuSlotMap& map)
+            : table_(map.current_.load(std::memory_order_seq_cst)),
+              count_(table_->count.load(std::memory_order_acquire)) {}
+
+        // Dense positions, erased ones included
+        std::size_t size() const { return count_; }
+
+        // Visits live elements at dense positions [begin, end)
+        template<typename Fn>
+        void forEach(std::size_t begin, std::size_t end, Fn fn) const {
+            const Entry* entries = table_->entries.get();
+            for (std::size_t i = begin; i < std::min(end, count_); ++i) {
+                if (entries[i].live.load(std::memory_order_acquire)) {
+                    fn(entries[i].value);
+                }
+            }
+        }
+    };
+
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        EpochDomain::ReadGuard guard;
+        const Table* table = current_.load(std::memory_order_seq_cst);
+        std::size_t count = table->count.load(std::memory_order_acquire);
+        const Entry* entries = table->entries.get();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (entries[i].live.load(std::memory_order_acquire)) {
+                fn(entries[i].value);
+            }
+        }
+    }
+
+    std::size_t size() const {
+        return live_.load(std::memory_order_relaxed);
+    }
+
+private:
+    bool isCurrent(SlotHandle handle) const {
+        return handle.index < slots_.size() && slots_[handle.index].occupied &&
+               slots_[handle.index].generation == handle.generation;
+    }
+
+    bool eraseLocked(SlotHandle handle) {
+        if (!isCurrent(handle)) {
+            return false;
+        }
+        Slot& slot = slots_[handle.index];
+        Table* table = current_.load(std::memory_order_relaxed);
+        table->entries[slot.dense].live.store(false, std::memory_order_release);
+        {
+            // Views pinned on older arrays must not see the element either
+            std::lock_guard<std::mutex> lock(history_->mutex);
+            std::uint32_t dense = slot.dense;
+            for (const Table* newer = table; newer->previous != nullptr; newer = newer->previous) {
+                dense = newer->entries[dense].formerDense;
+                if (dense == kNoEntry) {
+                    break;
+                }
+                newer->previous->entries[dense].live.store(false, std::memory_order_release);
+            }
+        }
+        slot.occupied = false;
+        ++slot.generation;
+        freeSlots_.push_back(handle.index);
+        std::size_t live = live_.fetch_sub(1, std::memory_order_relaxed) - 1;
+
+        std::size_t dead = table->count.load(std::memory_order_relaxed) - live;
+        if (dead >= kMinCompaction && dead > live) {
+            rebuild(std::max(kMinCapacity, live * 2));
+        }
+        return true;
+    }
+
+    // Copies the live entries into a fresh table and publishes it
+    Table* rebuild(std::size_t capacity) {
+        Table* previous = current_.load(std::memory_order_relaxed);
+        auto* next = new Table(capacity);
+        std::size_t count = previous->count.load(std::memory_order_relaxed);
+        std::size_t dense = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const Entry& entry = previous->entries[i];
+            if (entry.live.load(std::memory_order_relaxed)) {
+                next->entries[dense].value = entry.value;
+                next->entries[dense].slot = entry.slot;
+                next->entries[dense].formerDense = static_cast<std::uint32_t>(i);
+                next->entries[dense].live.store(true, std::memory_order_relaxed);
+                slots_[entry.slot].dense = static_cast<std::uint32_t>(dense);
+                ++dense;
+            }
+        }
+        next->count.store(dense, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(history_->mutex);
+            next->previous = previous;
+            previous->next = next;
+        }
+        current_.store(next, std::memory_order_seq_cst);
+        retire(previous);
+        return next;
+    }
+
+    // Unlinks the array once it is reclaimed, so erasures stop reaching it
+    void retire(Table* table) {
+        EpochDomain::instance().retire([history = history_, table] {
+            {
+                std::lock_guard<std::mutex> lock(history->mutex);
+                if (table->previous != nullptr) {
+                    table->previous->next = nullptr;
+                }
+                if (table->next != nullptr) {
+                    table->next->previous = nullptr;
+                }
+            }
+            delete table;
+        });
+    }
+};
+
+#endif // RCU_HPP
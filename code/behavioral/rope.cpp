@@ -0,0 +1,197 @@
+#include "rope.hpp"
+#include <algorithm>
+
+// Leaves hold text and have height 1; inner nodes only hold children
+struct Rope::Node {
+    NodePtr left;
+    NodePtr right;
+    std::string text;
+    std::size_t length;
+    int height;
+};
+
+namespace {
+
+template<typename NodePtr>
+int heightOf(const NodePtr& node) {
+    return node ? node->height : 0;
+}
+
+template<typename NodePtr>
+std::size_t lengthOf(const NodePtr& node) {
+    return node ? node->length : 0;
+}
+
+}
+
+Rope::Rope(const std::string& text) : root_(build(text, 0, text.size())) {}
+
+std::size_t Rope::length() const {
+    return lengthOf(root_);
+}
+
+int Rope::height() const {
+    return heightOf(root_);
+}
+
+Rope::NodePtr Rope::build(const std::string& text, std::size_t begin, std::size_t end) {
+    if (begin >= end) {
+        return nullptr;
+    }
+    if (end - begin <= kLeafSize) {
+        return makeLeaf(text.substr(begin, end - begin));
+    }
+    // Split on a leaf boundary so every leaf but the last is full
+    std::size_t leaves = (end - begin + kLeafSize - 1) / kLeafSize;
+    std::size_t middle = begin + (leaves / 2) * kLeafSize;
+    return makeNode(build(text, begin, middle), build(text, middle, end));
+}
+
+Rope::NodePtr Rope::makeLeaf(std::string text) {
+    if (text.empty()) {
+        return nullptr;
+    }
+    std::size_t length = text.size();
+    return std::make_shared<const Node>(Node{nullptr, nullptr, std::move(text), length, 1});
+}
+
+Rope::NodePtr Rope::makeNode(NodePtr left, NodePtr right) {
+    std::size_t length = lengthOf(left) + lengthOf(right);
+    int height = 1 + std::max(heightOf(left), heightOf(right));
+    return std::make_shared<const Node>(Node{std::move(left), std::move(right), std::string(), length, height});
+}
+
+// Builds a node from subtrees whose heights differ by at most 2
+Rope::NodePtr Rope::balance(NodePtr left, NodePtr right) {
+    int leftHeight = heightOf(left);
+    int rightHeight = heightOf(right);
+    if (leftHeight > rightHeight + 1) {
+        if (heightOf(left->left) >= heightOf(left->right)) {
+            return makeNode(left->left, makeNode(left->right, std::move(right)));
+        }
+        return makeNode(makeNode(left->left, left->right->left),
+                        makeNode(left->right->right, std::move(right)));
+    }
+    if (rightHeight > leftHeight + 1) {
+        if (heightOf(right->right) >= heightOf(right->left)) {
+            return makeNode(makeNode(std::move(left), right->left), right->right);
+        }
+        return makeNode(makeNode(std::move(left), right->left->left),
+                        makeNode(right->left->right, right->right));
+    }
+    return makeNode(std::move(left), std::move(right));
+}
+
+// AVL join: walks down the taller tree's spine until heights match, so the
+// cost is proportional to the height difference
+Rope::NodePtr Rope::join(NodePtr left, NodePtr right) {
+    if (!left) {
+        return right;
+    }
+    if (!right) {
+        return left;
+    }
+    // Keep small edits from fragmenting the text into tiny leaves
+    if (left->height == 1 && right->height == 1 && left->length + right->length <= kLeafSize) {
+        return makeLeaf(left->text + right->text);
+    }
+    if (left->height > right->height + 1) {
+        return balance(left->left, join(left->right, std::move(right)));
+    }
+    if (right->height > left->height + 1) {
+        return balance(join(std::move(left), right->left), right->right);
+    }
+    return makeNode(std::move(left), std::move(right));
+}
+
+std::pair<Rope::NodePtr, Rope::NodePtr> Rope::split(const NodePtr& node, std::size_t position) {
+    if (!node) {
+        return {nullptr, nullptr};
+    }
+    if (position == 0) {
+        return {nullptr, node};
+    }
+    if (position >= node->length) {
+        return {node, nullptr};
+    }
+    if (node->height == 1) {
+        return {makeLeaf(node->text.substr(0, position)), makeLeaf(node->text.substr(position))};
+    }
+    std::size_t leftLength = lengthOf(node->left);
+    if (position <= leftLength) {
+        auto [first, second] = split(node->left, position);
+        return {first, join(second, node->right)};
+    }
+    auto [first, second] = split(node->right, position - leftLength);
+    return {join(node->left, first), second};
+}
+
+Rope Rope::insert(std::size_t position, const std::string& text) const {
+    auto [left, right] = split(root_, std::min(position, length()));
+    return Rope(join(join(left, build(text, 0, text.size())), right));
+}
+
+Rope Rope::erase(std::size_t position, std::size_t count) const {
+    position = std::min(position, length());
+    count = std::min(count, length() - position);
+    auto [left, rest] = split(root_, position);
+    auto [removed, right] = split(rest, count);
+    return Rope(join(left, right));
+}
+
+Rope Rope::concat(const Rope& other) const {
+    return Rope(join(root_, other.root_));
+}
+
+char Rope::charAt(std::size_t index) const {
+    const Node* node = root_.get();
+    while (node != nullptr && node->height > 1) {
+        std::size_t leftLength = lengthOf(node->left);
+        if (index < leftLength) {
+            node = node->left.get();
+        } else {
+            index -= leftLength;
+            node = node->right.get();
+        }
+    }
+    return node != nullptr && index < node->text.size() ? node->text[index] : '\0';
+}
+
+void Rope::append(const NodePtr& node, std::size_t begin, std::size_t end, std::string& out) {
+    if (!node || begin >= end) {
+        return;
+    }
+    if (node->height == 1) {
+        out.append(node->text, begin, end - begin);
+        return;
+    }
+    std::size_t leftLength = lengthOf(node->left);
+    if (begin < leftLength) {
+        append(node->left, begin, std::min(end, leftLength), out);
+    }
+    if (end > leftLength) {
+        append(node->right, begin > leftLength ? begin - leftLength : 0, end - leftLength, out);
+    }
+}
+
+std::string Rope::substr(std::size_t position, std::size_t count) const {
+    std::string out;
+    position = std::min(position, length());
+    count = std::min(count, length() - position);
+    out.reserve(count);
+    append(root_, position, position + count, out);
+    return out;
+}
+
+std::string Rope::toString() const {
+    return substr(0, length());
+}
+
+void Rope::Footprint::visit(const NodePtr& node) {
+    if (!node || !seen_.insert(node.get()).second) {
+        return;
+    }
+    bytes_ += sizeof(Node) + node->text.capacity();
+    visit(node->left);
+    visit(node->right);
+}
@@ -0,0 +1,68 @@
+#ifndef ROPE_HPP
+#define ROPE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+// Persistent rope: an immutable, height-balanced (AVL) tree of text chunks.
+//
+// Edits never modify a node; they build O(log n) new nodes along the edited
+// path and share everything else with the previous version. Copying a Rope
+// only copies the root pointer, so keeping old versions around is O(1) each
+// and they cost only the nodes that differ.
+class Rope {
+public:
+    static constexpr std::size_t kLeafSize = 512;
+
+    Rope() = default;
+    explicit Rope(const std::string& text);
+
+    std::size_t length() const;
+    bool empty() const { return length() == 0; }
+    char charAt(std::size_t index) const;
+    std::string substr(std::size_t position, std::size_t count) const;
+    std::string toString() const;
+
+    // Out-of-range positions are clamped to the end, like std::string::replace
+    Rope insert(std::size_t position, const std::string& text) const;
+    Rope erase(std::size_t position, std::size_t count) const;
+    Rope concat(const Rope& other) const;
+
+    int height() const;
+
+    class Footprint;
+
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    NodePtr root_;
+
+    explicit Rope(NodePtr root) : root_(std::move(root)) {}
+
+    static NodePtr build(const std::string& text, std::size_t begin, std::size_t end);
+    static NodePtr makeLeaf(std::string text);
+    static NodePtr makeNode(NodePtr left, NodePtr right);
+    static NodePtr balance(NodePtr left, NodePtr right);
+    static NodePtr join(NodePtr left, NodePtr right);
+    static std::pair<NodePtr, NodePtr> split(const NodePtr& node, std::size_t position);
+    static void append(const NodePtr& node, std::size_t begin, std::size_t end, std::string& out);
+};
+
+// Memory held by a set of ropes, counting the nodes they share only once
+class Rope::Footprint {
+    std::unordered_set<const Node*> seen_;
+    std::size_t bytes_ = 0;
+
+public:
+    void add(const Rope& rope) { visit(rope.root_); }
+    std::size_t getBytes() const { return bytes_; }
+
+private:
+    void visit(const NodePtr& node);
+};
+
+#endif // ROPE_HPP
@@ -0,0 +1,422 @@
+#include "sharded_mediator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Which shard loop, if any, the current thread is running
+thread_local const ShardedChatRoom* currentRoom = nullptr;
+thread_local std::size_t currentShard = 0;
+
+constexpr std::size_t kPollBatch = 256;
+
+}
+
+ShardedChatRoom::ShardedChatRoom(std::size_t shards, std::size_t queueCapacity)
+    : externalPosted_(0), running_(false) {
+    std::size_t count = shards > 0 ? shards : 1;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto shard = std::make_unique<Shard>();
+        for (std::size_t source = 0; source < count; ++source) {
+            shard->inbound.push_back(std::make_unique<SpscQueue<Envelope>>(queueCapacity));
+        }
+        shards_.push_back(std::move(shard));
+    }
+}
+
+ShardedChatRoom::~ShardedChatRoom() {
+    stop();
+}
+
+void ShardedChatRoom::addUser(std::shared_ptr<Colleague> user) {
+    if (running_.load()) {
+        throw std::logic_error("ShardedChatRoom::addUser must be called before start()");
+    }
+    if (userRooms_.try_emplace(user.get()).second) {
+        usersByName_[user->getName()] = user.get();
+        users_.push_back(std::move(user));
+    }
+}
+
+void ShardedChatRoom::join(RoomId room, std::shared_ptr<Colleague> user) {
+    if (running_.load()) {
+        throw std::logic_error("ShardedChatRoom::join must be called before start()");
+    }
+    Colleague* member = user.get();
+    addUser(std::move(user));
+    userRooms_[member].push_back(room);
+    std::size_t home = getUserShard(*member);
+    shards_[home]->rooms[room].push_back(member);
+    addShard(roomShards_[room], home);
+}
+
+void ShardedChatRoom::subscribe(const std::string& topic, Colleague* colleague) {
+    if (running_.load()) {
+        throw std::logic_error("ShardedChatRoom::subscribe must be called before start()");
+    }
+    if (!userRooms_.contains(colleague)) {
+        return;
+    }
+    auto [it, inserted] = topicIds_.try_emplace(topic, static_cast<std::uint32_t>(topicShards_.size()));
+    if (inserted) {
+        topicShards_.emplace_back();
+    }
+    std::size_t home = getUserShard(*colleague);
+    shards_[home]->topics[it->second].add(colleague);
+    addShard(topicShards_[it->second], home);
+}
+
+void ShardedChatRoom::unsubscribe(const std::string& topic, Colleague* colleague) {
+    auto it = topicIds_.find(topic);
+    if (it == topicIds_.end()) {
+        return;
+    }
+    std::size_t home = getUserShard(*colleague);
+    auto remove = [this, home, id = it->second, colleague]() {
+        auto& topics = shards_[home]->topics;
+        if (auto found = topics.find(id); found != topics.end()) {
+            found->second.remove(colleague);
+        }
+    };
+    // Once running, the member lists belong to the home shard's thread; a
+    // task also keeps a receive() that unsubscribes from cutting a delivery short
+    if (running_.load()) {
+        post(home, std::move(remove));
+    } else {
+        remove();
+    }
+}
+
+void ShardedChatRoom::addShard(std::vector<std::size_t>& shards, std::size_t shard) {
+    // Set-up only, and there are few shards
+    if (std::find(shards.begin(), shards.end(), shard) == shards.end()) {
+        shards.push_back(shard);
+    }
+}
+
+void ShardedChatRoom::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        shards_[i]->thread = std::thread([this, i]() { loop(i); });
+    }
+}
+
+void ShardedChatRoom::stop() {
+    if (!running_.load()) {
+        return;
+    }
+    // Nothing may still be queued for a shard when it exits
+    waitIdle();
+    if (!running_.exchange(false)) {
+        return;
+    }
+    for (auto& shard : shards_) {
+        shard->thread.join();
+    }
+}
+
+void ShardedChatRoom::sendMessage(const Message& message, Colleague* sender) {
+    auto it = userRooms_.find(sender);
+    if (it == userRooms_.end()) {
+        return;
+    }
+    for (RoomId room : it->second) {
+        sendToRoom(room, message, sender);
+    }
+}
+
+void ShardedChatRoom::sendToRoom(RoomId room, const Message& message, Colleague* sender) {
+    auto it = roomShards_.find(room);
+    if (it == roomShards_.end()) {
+        return;
+    }
+    for (std::size_t shard : it->second) {
+        route(shard, Envelope{Target::Room, room, nullptr, message, sender});
+    }
+}
+
+void ShardedChatRoom::sendMessageTo(const std::string& recipient, const Message& message, Colleague* sender) {
+    auto it = usersByName_.find(recipient);
+    if (it == usersByName_.end() || it->second == sender) {
+        return;
+    }
+    route(getUserShard(*it->second), Envelope{Target::User, 0, it->second, message, sender});
+}
+
+void ShardedChatRoom::publishMessage(const std::string& topic, const Message& message, Colleague* sender) {
+    auto it = topicIds_.find(topic);
+    if (it == topicIds_.end()) {
+        return;
+    }
+    for (std::size_t shard : topicShards_[it->second]) {
+        route(shard, Envelope{Target::Topic, it->second, nullptr, message, sender});
+    }
+}
+
+void ShardedChatRoom::route(std::size_t target, Envelope envelope) {
+    if (currentRoom != this) {
+        // Outside the pool: hand the envelope over as a task
+        post(target, [this, target, envelope]() { deliver(*shards_[target], envelope); });
+        return;
+    }
+
+    if (target == currentShard) {
+        deliver(*shards_[target], envelope);
+        return;
+    }
+
+    Shard& self = *shards_[currentShard];
+    auto& queue = *shards_[target]->inbound[currentShard];
+    // Count before publishing so waitIdle never sees more processed than posted
+    self.posted.fetch_add(1, std::memory_order_seq_cst);
+    while (!queue.tryPush(envelope)) {
+        if (!running_.load(std::memory_order_relaxed)) {
+            // Stopping: the target may already have exited, so give up
+            self.processed.fetch_add(1, std::memory_order_seq_cst);
+            return;
+        }
+        // Keep draining our own inbox so two full shards cannot deadlock
+        if (!pollOnce(currentShard, false)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ShardedChatRoom::post(std::size_t shard, std::function<void()> task) {
+    Shard& target = *shards_[shard % shards_.size()];
+    externalPosted_.fetch_add(1, std::memory_order_seq_cst);
+    {
+        std::lock_guard<std::mutex> lock(target.externalMutex);
+        target.externalTasks.push_back(std::move(task));
+        target.hasExternal.store(true, std::memory_order_release);
+    }
+}
+
+void ShardedChatRoom::deliver(Shard& shard, const Envelope& envelope) {
+    std::uint64_t count = 0;
+    auto deliverTo = [&](Colleague* member) {
+        if (member != envelope.sender) {
+            member->receive(envelope.message);
+            ++count;
+        }
+    };
+    switch (envelope.target) {
+        case Target::Room:
+            if (auto it = shard.rooms.find(envelope.id); it != shard.rooms.end()) {
+                std::for_each(it->second.begin(), it->second.end(), deliverTo);
+            }
+            break;
+        case Target::Topic:
+            if (auto it = shard.topics.find(envelope.id); it != shard.topics.end()) {
+                const auto& members = it->second.getMembers();
+                std::for_each(members.begin(), members.end(), deliverTo);
+            }
+            break;
+        case Target::User:
+            deliverTo(envelope.recipient);
+            break;
+    }
+    shard.delivered.fetch_add(count, std::memory_order_relaxed);
+}
+
+bool ShardedChatRoom::pollOnce(std::size_t index, bool runTasks) {
+    Shard& shard = *shards_[index];
+    bool worked = false;
+
+    for (std::size_t source = 0; source < shard.inbound.size(); ++source) {
+        auto& queue = *shard.inbound[source];
+        std::uint64_t count = 0;
+        while (count < kPollBatch) {
+            auto envelope = queue.tryPop();
+            if (!envelope) {
+                break;
+            }
+            deliver(shard, *envelope);
+            ++count;
+        }
+        if (count > 0) {
+            shard.processed.fetch_add(count, std::memory_order_seq_cst);
+            worked = true;
+        }
+    }
+
+    if (runTasks && shard.hasExternal.load(std::memory_order_acquire)) {
+        std::vector<std::function<void()>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(shard.externalMutex);
+            tasks.swap(shard.externalTasks);
+            shard.hasExternal.store(false, std::memory_order_relaxed);
+        }
+        for (auto& task : tasks) {
+            task();
+            shard.processed.fetch_add(1, std::memory_order_seq_cst);
+        }
+        worked = worked || !tasks.empty();
+    }
+
+    return worked;
+}
+
+void ShardedChatRoom::loop(std::size_t index) {
+    currentRoom = this;
+    currentShard = index;
+
+    while (running_.load(std::memory_order_relaxed)) {
+        if (!pollOnce(index, true)) {
+            std::this_thread::yield();
+        }
+    }
+    while (pollOnce(index, true)) {
+    }
+
+    currentRoom = nullptr;
+}
+
+void ShardedChatRoom::waitIdle() const {
+    auto totalPosted = [this]() {
+        std::uint64_t total = externalPosted_.load(std::memory_order_seq_cst);
+        for (const auto& shard : shards_) {
+            total += shard->posted.load(std::memory_order_seq_cst);
+        }
+        return total;
+    };
+    auto totalProcessed = [this]() {
+        std::uint64_t total = 0;
+        for (const auto& shard : shards_) {
+            total += shard->processed.load(std::memory_order_seq_cst);
+        }
+        return total;
+    };
+
+    // Work is only posted before its parent finishes, so a stable posted
+    // count that matches the processed count means nothing is in flight
+    for (;;) {
+        std::uint64_t before = totalPosted();
+        std::uint64_t processed = totalProcessed();
+        std::uint64_t after = totalPosted();
+        if (before == after && processed == after) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+std::size_t ShardedChatRoom::getUserShard(const Colleague& user) const {
+    return std::hash<std::string>{}(user.getName()) % shards_.size();
+}
+
+std::uint64_t ShardedChatRoom::getDeliveredCount() const {
+    std::uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard->delivered.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+namespace {
+
+// Colleague that only counts what it receives; it belongs to a single room,
+// so only that room's shard ever touches it
+class CountingUser : public Colleague {
+    std::uint64_t received_;
+public:
+    CountingUser(Mediator* mediator, const std::string& name)
+        : Colleague(mediator, name), received_(0) {}
+
+    void send(const std::string& message) override {
+        mediator_->sendMessage(Message(name_, message), this);
+    }
+
+    void receive(const std::string&) override { ++received_; }
+    void receive(const Message&) override { ++received_; }
+};
+
+}
+
+void demonstrateShardedMediator() {
+    std::cout << "\n=== Sharded Mediator Demo ===\n" << std::endl;
+
+    ShardedChatRoom room(2);
+    auto alice = std::make_shared<User>(&room, "Alice");
+    auto bob = std::make_shared<User>(&room, "Bob");
+    auto charlie = std::make_shared<User>(&room, "Charlie");
+    auto dave = std::make_shared<User>(&room, "Dave");
+
+    room.join(0, alice);
+    room.join(0, bob);
+    room.join(1, charlie);
+    room.join(1, dave);
+    room.join(1, alice);
+    room.subscribe("weather", bob.get());
+    room.subscribe("weather", dave.get());
+    room.start();
+
+    std::cout << "Alice is in rooms 0 and 1, Bob in 0, Charlie and Dave in 1; home shards: Alice "
+              << room.getUserShard(*alice) << ", Bob " << room.getUserShard(*bob) << ", Charlie "
+              << room.getUserShard(*charlie) << ", Dave " << room.getUserShard(*dave) << std::endl;
+    room.post(room.getUserShard(*alice), [alice]() { alice->send("Hello both rooms!"); });
+    room.waitIdle();
+    room.post(room.getUserShard(*dave), [dave]() {
+        dave->send("Hi from room 1");
+        dave->sendTo("Alice", "Just to you");
+    });
+    room.waitIdle();
+    room.post(room.getUserShard(*charlie), [charlie]() { charlie->publish("weather", "Rain later"); });
+    room.waitIdle();
+    room.stop();
+
+    std::cout << "Deliveries: " << room.getDeliveredCount() << std::endl;
+    std::cout << "\n=== End Sharded Mediator Demo ===\n" << std::endl;
+}
+
+void benchmarkShardedMediator(std::size_t users, RoomId rooms, std::size_t messages) {
+    std::cout << "\n=== Sharded Mediator Benchmark ===\n" << std::endl;
+    std::cout << users << " users, " << rooms << " rooms, " << messages << " messages" << std::endl;
+
+    std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> shardCounts;
+    for (std::size_t shards = 1; shards < cores; shards *= 2) {
+        shardCounts.push_back(shards);
+    }
+    shardCounts.push_back(cores);
+
+    const std::string text = "synthetic load";
+    for (std::size_t shards : shardCounts) {
+        ShardedChatRoom room(shards);
+        std::vector<std::vector<std::shared_ptr<CountingUser>>> usersByShard(shards);
+        for (std::size_t i = 0; i < users; ++i) {
+            auto user = std::make_shared<CountingUser>(&room, "user" + std::to_string(i));
+            room.join(static_cast<RoomId>(i % rooms), user);
+            usersByShard[room.getUserShard(*user)].push_back(user);
+        }
+        room.start();
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t s = 0; s < shards; ++s) {
+            room.post(s, [&usersByShard, &text, s, messages, shards]() {
+                auto& local = usersByShard[s];
+                if (local.empty()) {
+                    return;
+                }
+                for (std::size_t k = 0; k < messages / shards; ++k) {
+                    local[k % local.size()]->send(text);
+                }
+            });
+        }
+        room.waitIdle();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        room.stop();
+
+        std::cout << shards << " shard(s): "
+                  << static_cast<double>(messages) / seconds / 1e6 << " M messages/s, "
+                  << static_cast<double>(room.getDeliveredCount()) / seconds / 1e6
+                  << " M deliveries/s" << std::endl;
+    }
+
+    std::cout << "\n=== End Sharded Mediator Benchmark ===\n" << std::endl;
+}
@@ -0,0 +1,167 @@
+#ifndef SHARDED_MEDIATOR_HPP
+#define SHARDED_MEDIATOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "mediator.hpp"
+
+// Bounded single-producer, single-consumer queue.
+// The producer owns tail_, the consumer owns head_; each side only reads the
+// other's index, so pushes and pops need no read-modify-write at all.
+template<typename T>
+class SpscQueue {
+    std::unique_ptr<std::optional<T>[]> slots_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> head_;
+    alignas(64) std::atomic<std::size_t> tail_;
+
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscQueue(std::size_t capacity) : head_(0), tail_(0) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots_.reset(new std::optional<T>[size]);
+        mask_ = size - 1;
+    }
+
+    bool tryPush(T value) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_) {
+            return false;
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> tryPop() {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        std::optional<T> value = std::move(slots_[head & mask_]);
+        slots_[head & mask_].reset();
+        head_.store(head + 1, std::memory_order_release);
+        return value;
+    }
+};
+
+using RoomId = std::uint32_t;
+
+// Concrete Mediator: chat rooms partitioned across shards, one thread each.
+//
+// Every user has a home shard, picked by a hash of its name, and only that
+// shard's thread ever calls its receive(); work done on the user's behalf
+// (see post) runs there too. A room or topic keeps, on each shard, the list
+// of its members homed there, so a send is handed to every shard that has
+// members and each shard delivers to its own. An envelope from shard i to
+// shard j travels through the dedicated SPSC queue i -> j, so shards never
+// share a lock on the hot path. Calls from threads outside the pool go
+// through a small locked inbox instead.
+//
+// Users, rooms and topics must be set up with addUser(), join() and
+// subscribe() before start(); unsubscribe() may be called at any time.
+// stop() lets in-flight work finish first; envelopes sent between shards
+// after that are dropped.
+class ShardedChatRoom : public Mediator {
+    enum class Target : std::uint8_t {
+        Room,
+        Topic,
+        User
+    };
+
+    struct Envelope {
+        Target target;
+        std::uint32_t id;       // room or topic
+        Colleague* recipient;   // Target::User only
+        Message message;
+        Colleague* sender;
+    };
+
+    struct alignas(64) Shard {
+        // Members homed on this shard, by room and by topic
+        std::unordered_map<RoomId, std::vector<Colleague*>> rooms;
+        std::unordered_map<std::uint32_t, SubscriberList<Colleague>> topics;
+        // inbound[i] carries envelopes sent from shard i
+        std::vector<std::unique_ptr<SpscQueue<Envelope>>> inbound;
+        std::mutex externalMutex;
+        std::vector<std::function<void()>> externalTasks;
+        std::atomic<bool> hasExternal{false};
+        alignas(64) std::atomic<std::uint64_t> posted{0};
+        alignas(64) std::atomic<std::uint64_t> processed{0};
+        std::atomic<std::uint64_t> delivered{0};
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    // Set up before start() and read-only afterwards
+    std::vector<std::shared_ptr<Colleague>> users_;
+    std::unordered_map<std::string, Colleague*> usersByName_;
+    std::unordered_map<const Colleague*, std::vector<RoomId>> userRooms_;
+    std::unordered_map<RoomId, std::vector<std::size_t>> roomShards_;
+    std::unordered_map<std::string, std::uint32_t> topicIds_;
+    std::vector<std::vector<std::size_t>> topicShards_;
+
+    std::atomic<std::uint64_t> externalPosted_;
+    std::atomic<bool> running_;
+
+public:
+    using Mediator::sendMessage;
+
+    explicit ShardedChatRoom(std::size_t shards = std::thread::hardware_concurrency(),
+                             std::size_t queueCapacity = 4096);
+    ~ShardedChatRoom() override;
+
+    ShardedChatRoom(const ShardedChatRoom&) = delete;
+    ShardedChatRoom& operator=(const ShardedChatRoom&) = delete;
+
+    // A later user with the same name takes over directed messages
+    void addUser(std::shared_ptr<Colleague> user);
+    // Adds the user first if needed
+    void join(RoomId room, std::shared_ptr<Colleague> user);
+    // Colleagues must have been added to the room before subscribing
+    void subscribe(const std::string& topic, Colleague* colleague);
+    void unsubscribe(const std::string& topic, Colleague* colleague);
+
+    void start();
+    void stop();
+
+    // Broadcasts to every room the sender has joined
+    void sendMessage(const Message& message, Colleague* sender) override;
+    void sendToRoom(RoomId room, const Message& message, Colleague* sender);
+    void sendMessageTo(const std::string& recipient, const Message& message, Colleague* sender) override;
+    void publishMessage(const std::string& topic, const Message& message, Colleague* sender) override;
+
+    // Runs a task on the given shard's loop thread
+    void post(std::size_t shard, std::function<void()> task);
+    // Blocks until every queued envelope and task has been processed
+    void waitIdle() const;
+
+    std::size_t getShardCount() const { return shards_.size(); }
+    std::size_t getUserShard(const Colleague& user) const;
+    std::uint64_t getDeliveredCount() const;
+
+private:
+    static void addShard(std::vector<std::size_t>& shards, std::size_t shard);
+    void route(std::size_t target, Envelope envelope);
+    void deliver(Shard& shard, const Envelope& envelope);
+    bool pollOnce(std::size_t index, bool runTasks);
+    void loop(std::size_t index);
+};
+
+void demonstrateShardedMediator();
+void benchmarkShardedMediator(std::size_t users = 1'000'000, RoomId rooms = 10'000,
+                              std::size_t messages = 200'000);
+
+#endif // SHARDED_MEDIATOR_HPP
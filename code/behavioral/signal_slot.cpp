@@ -0,0 +1,114 @@
+#include "signal_slot.hpp"
+#include "observer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Running temperature total; the same work behind both dispatch styles
+struct TemperatureTotal {
+    double sum = 0.0;
+    std::uint64_t count = 0;
+
+    void operator()(float temperature, float, float) {
+        sum += temperature;
+        ++count;
+    }
+};
+
+class TemperatureTotalObserver : public Observer {
+    TemperatureTotal total_;
+public:
+    void update(float temperature, float humidity, float pressure) override {
+        total_(temperature, humidity, pressure);
+    }
+    const TemperatureTotal& getTotal() const { return total_; }
+};
+
+struct FrostAlarm {
+    float threshold;
+    int alarms = 0;
+
+    void operator()(float temperature, float, float) {
+        if (temperature <= threshold) {
+            ++alarms;
+            std::cout << "Frost alarm: " << temperature << "°C" << std::endl;
+        }
+    }
+};
+
+float temperatureAt(std::size_t notification) {
+    return 20.0f + static_cast<float>(notification % 100) * 0.01f;
+}
+
+template<std::size_t Count>
+void compareDispatch(std::size_t updates) {
+    using Clock = std::chrono::steady_clock;
+    std::size_t notifications = std::max<std::size_t>(1, updates / Count);
+
+    WeatherStation station;
+    std::vector<std::shared_ptr<TemperatureTotalObserver>> observers;
+    for (std::size_t i = 0; i < Count; ++i) {
+        observers.push_back(std::make_shared<TemperatureTotalObserver>());
+        station.registerObserver(observers.back());
+    }
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < notifications; ++i) {
+        station.setMeasurements(temperatureAt(i), 60.0f, 1013.0f);
+    }
+    double virtualNanos = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    StaticSignal<SlotArray<TemperatureTotal, Count>> signal;
+    start = Clock::now();
+    for (std::size_t i = 0; i < notifications; ++i) {
+        signal.emit(temperatureAt(i), 60.0f, 1013.0f);
+    }
+    double staticNanos = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    const TemperatureTotal& expected = observers.front()->getTotal();
+    const TemperatureTotal& actual = signal.template slot<0>()[0];
+    bool agree = expected.count == actual.count && expected.sum == actual.sum;
+
+    double delivered = static_cast<double>(notifications * Count);
+    std::cout << Count << (Count == 1 ? " observer: " : " observers: ")
+              << "WeatherStation " << virtualNanos / delivered << " ns, StaticSignal "
+              << staticNanos / delivered << " ns per update (" << virtualNanos / staticNanos << "x)"
+              << (agree ? "" : " [totals differ]") << std::endl;
+}
+
+}
+
+void demonstrateSignalSlot() {
+    std::cout << "\n=== Signal/Slot Demo ===\n" << std::endl;
+
+    CurrentConditionsDisplay display("Panel");
+    StaticSignal signal(
+        // Qualified call: no virtual dispatch even through an Observer type
+        [&display](float temperature, float humidity, float pressure) {
+            display.CurrentConditionsDisplay::update(temperature, humidity, pressure);
+        },
+        FrostAlarm{0.0f},
+        SlotArray<TemperatureTotal, 3>{});
+
+    signal.emit(4.0f, 70.0f, 1020.0f);
+    signal.emit(-1.5f, 85.0f, 1018.0f);
+
+    std::cout << signal.size() << " slots, " << signal.slot<1>().alarms << " frost alarm(s), "
+              << signal.slot<2>()[0].count << " readings totalled per counter" << std::endl;
+
+    std::cout << "\n=== End Signal/Slot Demo ===\n" << std::endl;
+}
+
+void benchmarkSignalSlot(std::size_t updates) {
+    std::cout << "\n=== Signal/Slot Benchmark ===\n" << std::endl;
+
+    compareDispatch<1>(updates);
+    compareDispatch<10>(updates);
+    compareDispatch<1000>(updates);
+
+    std::cout << "\n=== End Signal/Slot Benchmark ===\n" << std::endl;
+}
@@ -0,0 +1,75 @@
+#ifndef SIGNAL_SLOT_HPP
+#define SIGNAL_SLOT_HPP
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+// Compile-time alternative to Subject/Observer for internal wiring.
+//
+// The set of slot types is part of the signal's type, and the slots are
+// stored by value inside it: connecting costs no allocation, and emit() is a
+// fold over the slots that calls each one directly, so the compiler can
+// inline every slot into the emitting loop. The price is that slots cannot be
+// added or removed at run time; use WeatherStation where that matters.
+//
+//     StaticSignal signal(
+//         [&](float t, float, float) { thermostat.adjust(t); },
+//         SlotArray<Logger, 4>{});
+//     signal.emit(21.5f, 60.0f, 1013.0f);
+template<typename... Slots>
+class StaticSignal {
+    std::tuple<Slots...> slots_;
+
+public:
+    StaticSignal() = default;
+    explicit StaticSignal(Slots... slots) : slots_(std::move(slots)...) {}
+
+    // Calls every slot in declaration order
+    template<typename... Args>
+    void emit(const Args&... args) {
+        std::apply([&args...](Slots&... slots) { (slots(args...), ...); }, slots_);
+    }
+
+    template<std::size_t Index>
+    auto& slot() { return std::get<Index>(slots_); }
+
+    template<std::size_t Index>
+    const auto& slot() const { return std::get<Index>(slots_); }
+
+    static constexpr std::size_t size() { return sizeof...(Slots); }
+};
+
+// Count instances of one slot type, stored inline; usable as a single slot
+// of a StaticSignal when many observers share a type.
+template<typename Slot, std::size_t Count>
+class SlotArray {
+    std::array<Slot, Count> slots_{};
+
+public:
+    SlotArray() = default;
+    explicit SlotArray(const std::array<Slot, Count>& slots) : slots_(slots) {}
+
+    template<typename... Args>
+    void operator()(const Args&... args) {
+        for (Slot& slot : slots_) {
+            slot(args...);
+        }
+    }
+
+    Slot& operator[](std::size_t index) { return slots_[index]; }
+    const Slot& operator[](std::size_t index) const { return slots_[index]; }
+
+    auto begin() { return slots_.begin(); }
+    auto end() { return slots_.end(); }
+    auto begin() const { return slots_.begin(); }
+    auto end() const { return slots_.end(); }
+
+    static constexpr std::size_t size() { return Count; }
+};
+
+void demonstrateSignalSlot();
+void benchmarkSignalSlot(std::size_t updates = 100'000'000);
+
+#endif // SIGNAL_SLOT_HPP
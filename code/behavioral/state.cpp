@@ -1,13 +1,54 @@
 #include "state.hpp"
+#include <chrono>
 #include <iostream>
+#include <random>
+#include <vector>
+
+constexpr VendingMachine::Transitions VendingMachine::kTransitions = [] {
+    using S = VendingState;
+    using E = VendingEvent;
+    Transitions table;
+
+    table.on(S::Idle, E::InsertCoin, S::HasMoney, [](VendingMachine& m) { m.say("You inserted a coin"); })
+         .on(S::Idle, E::EjectCoin, S::Idle, [](VendingMachine& m) { m.say("You haven't inserted a coin"); })
+         .on(S::Idle, E::TurnCrank, S::Idle, [](VendingMachine& m) { m.say("You turned, but there's no coin"); })
+         .on(S::Idle, E::Dispense, S::Idle, [](VendingMachine& m) { m.say("You need to pay first"); });
+
+    table.on(S::HasMoney, E::InsertCoin, S::HasMoney,
+             [](VendingMachine& m) { m.say("You can't insert another coin"); })
+         .on(S::HasMoney, E::EjectCoin, S::Idle, [](VendingMachine& m) { m.say("Coin returned"); })
+         .on(S::HasMoney, E::TurnCrank, S::Sold, [](VendingMachine& m) { m.say("You turned..."); })
+         .on(S::HasMoney, E::Dispense, S::HasMoney, [](VendingMachine& m) { m.say("No ball dispensed"); });
+
+    table.on(S::Sold, E::InsertCoin, S::Sold,
+             [](VendingMachine& m) { m.say("Please wait, we're already giving you a ball"); })
+         .on(S::Sold, E::EjectCoin, S::Sold,
+             [](VendingMachine& m) { m.say("Sorry, you already turned the crank"); })
+         .on(S::Sold, E::TurnCrank, S::Sold,
+             [](VendingMachine& m) { m.say("Turning twice doesn't get you another ball!"); })
+         .on(S::Sold, E::Dispense, [](VendingMachine& m) { m.releaseBall(); },
+             [](const VendingMachine& m) { return m.getCount() > 0; }, S::Idle, S::SoldOut);
+
+    table.on(S::SoldOut, E::InsertCoin, S::SoldOut,
+             [](VendingMachine& m) { m.say("Sorry, the machine is sold out"); })
+         .on(S::SoldOut, E::EjectCoin, S::SoldOut,
+             [](VendingMachine& m) { m.say("You can't eject, you haven't inserted a coin yet"); })
+         .on(S::SoldOut, E::TurnCrank, S::SoldOut,
+             [](VendingMachine& m) { m.say("You turned, but there are no balls"); })
+         .on(S::SoldOut, E::Dispense, S::SoldOut, [](VendingMachine& m) { m.say("No ball dispensed"); });
+
+    return table;
+}();
+
+static_assert(VendingMachine::kTransitions.at(VendingState::HasMoney, VendingEvent::TurnCrank).next ==
+              VendingState::Sold);
 
 // VendingMachine constructor
-VendingMachine::VendingMachine(int count) : count_(count) {
-    if (count > 0) {
-        setState(std::make_shared<IdleState>());
-    } else {
-        setState(std::make_shared<SoldOutState>());
-    }
+VendingMachine::VendingMachine(int count, std::ostream* log)
+    : machine_(kTransitions, count > 0 ? VendingState::Idle : VendingState::SoldOut), count_(count), log_(log) {}
+
+void VendingMachine::fire(VendingEvent event) {
+    machine_.fire(event, *this);
 }
 
 void demonstrateStatePattern() {
@@ -35,4 +76,37 @@ void demonstrateStatePattern() {
     machine.dispense();
 
     std::cout << "\n=== End State Pattern Demo ===\n" << std::endl;
-} 
\ No newline at end of file
+} 
+
+void benchmarkVendingMachine(std::size_t transitions) {
+    std::cout << "\n=== Vending Machine Benchmark ===\n" << std::endl;
+
+    // A random mix of events, so both the state sequence and the branch
+    // outcomes are hard to predict
+    constexpr std::size_t kEvents = 1 << 16;
+    std::vector<VendingEvent> events(kEvents);
+    std::mt19937 random(17);
+    for (auto& event : events) {
+        event = static_cast<VendingEvent>(random() % enumCount<VendingEvent>);
+    }
+
+    constexpr int kBalls = 1'000'000'000;
+    VendingMachine machine(kBalls, nullptr);
+    std::size_t visits[enumCount<VendingState>] = {};
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < transitions; ++i) {
+        machine.fire(events[i & (kEvents - 1)]);
+        ++visits[static_cast<std::size_t>(machine.getState())];
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << transitions << " events in " << seconds * 1e3 << " ms: "
+              << static_cast<double>(transitions) / seconds / 1e6 << " million transitions/s ("
+              << seconds * 1e9 / static_cast<double>(transitions) << " ns each)" << std::endl;
+    std::cout << "Balls sold: " << kBalls - machine.getCount() << "; time in Idle/HasMoney/Sold: "
+              << visits[0] << "/" << visits[1] << "/" << visits[2] << std::endl;
+
+    std::cout << "\n=== End Vending Machine Benchmark ===\n" << std::endl;
+}
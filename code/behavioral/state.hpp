@@ -1,145 +1,89 @@
 #ifndef STATE_HPP
 #define STATE_HPP
 
+#include <cstddef>
 #include <iostream>
-#include <memory>
+#include "state_machine.hpp"
 
-// Forward declarations
-class VendingMachine;
+// States and events of the vending machine
+enum class VendingState {
+    Idle,
+    HasMoney,
+    Sold,
+    SoldOut,
+    Count
+};
 
-// State interface
-class State {
-public:
-    virtual ~State() = default;
-    virtual void insertCoin(VendingMachine* machine) = 0;
-    virtual void ejectCoin(VendingMachine* machine) = 0;
-    virtual void turnCrank(VendingMachine* machine) = 0;
-    virtual void dispense(VendingMachine* machine) = 0;
+enum class VendingEvent {
+    InsertCoin,
+    EjectCoin,
+    TurnCrank,
+    Dispense,
+    Count
 };
 
 // Context: Vending Machine
+// What each state does with each event, and which state follows, is one
+// constexpr table (see state.cpp) instead of a class per state.
 class VendingMachine {
-    std::shared_ptr<State> state_;
+public:
+    using Transitions = TransitionTable<VendingState, VendingEvent, VendingMachine>;
+    static const Transitions kTransitions;
+
+private:
+    StateMachine<VendingState, VendingEvent, VendingMachine> machine_;
     int count_;
+    std::ostream* log_;
+
 public:
-    VendingMachine(int count);
-    
-    void setState(std::shared_ptr<State> state) {
-        state_ = state;
+    // Messages go to log; nullptr keeps the machine quiet
+    explicit VendingMachine(int count, std::ostream* log = &std::cout);
+
+    void setState(VendingState state) {
+        machine_.setState(state);
     }
-    
+
+    VendingState getState() const {
+        return machine_.getState();
+    }
+
+    void fire(VendingEvent event);
+
     void insertCoin() {
-        state_->insertCoin(this);
+        fire(VendingEvent::InsertCoin);
     }
-    
+
     void ejectCoin() {
-        state_->ejectCoin(this);
+        fire(VendingEvent::EjectCoin);
     }
-    
+
     void turnCrank() {
-        state_->turnCrank(this);
+        fire(VendingEvent::TurnCrank);
     }
-    
+
     void dispense() {
-        state_->dispense(this);
+        fire(VendingEvent::Dispense);
     }
-    
+
     int getCount() const { return count_; }
     void setCount(int count) { count_ = count; }
-    
+
     void releaseBall() {
         if (count_ > 0) {
-            std::cout << "A ball comes rolling out the slot..." << std::endl;
+            say("A ball comes rolling out the slot...");
             count_--;
         }
     }
-};
 
-// Concrete States
-class IdleState : public State {
-public:
-    void insertCoin(VendingMachine* machine) override {
-        std::cout << "You inserted a coin" << std::endl;
-        // Change to HasMoneyState
-    }
-    
-    void ejectCoin(VendingMachine* machine) override {
-        std::cout << "You haven't inserted a coin" << std::endl;
-    }
-    
-    void turnCrank(VendingMachine* machine) override {
-        std::cout << "You turned, but there's no coin" << std::endl;
-    }
-    
-    void dispense(VendingMachine* machine) override {
-        std::cout << "You need to pay first" << std::endl;
-    }
-};
-
-class HasMoneyState : public State {
-public:
-    void insertCoin(VendingMachine* machine) override {
-        std::cout << "You can't insert another coin" << std::endl;
-    }
-    
-    void ejectCoin(VendingMachine* machine) override {
-        std::cout << "Coin returned" << std::endl;
-        // Change to IdleState
-    }
-    
-    void turnCrank(VendingMachine* machine) override {
-        std::cout << "You turned..." << std::endl;
-        // Change to SoldState
-    }
-    
-    void dispense(VendingMachine* machine) override {
-        std::cout << "No ball dispensed" << std::endl;
-    }
-};
-
-class SoldState : public State {
-public:
-    void insertCoin(VendingMachine* machine) override {
-        std::cout << "Please wait, we're already giving you a ball" << std::endl;
-    }
-    
-    void ejectCoin(VendingMachine* machine) override {
-        std::cout << "Sorry, you already turned the crank" << std::endl;
-    }
-    
-    void turnCrank(VendingMachine* machine) override {
-        std::cout << "Turning twice doesn't get you another ball!" << std::endl;
-    }
-    
-    void dispense(VendingMachine* machine) override {
-        machine->releaseBall();
-        if (machine->getCount() > 0) {
-            // Change to IdleState
-        } else {
-            // Change to SoldOutState
+private:
+    void say(const char* message) const {
+        if (log_) {
+            *log_ << message << std::endl;
         }
     }
 };
 
-class SoldOutState : public State {
-public:
-    void insertCoin(VendingMachine* machine) override {
-        std::cout << "Sorry, the machine is sold out" << std::endl;
-    }
-    
-    void ejectCoin(VendingMachine* machine) override {
-        std::cout << "You can't eject, you haven't inserted a coin yet" << std::endl;
-    }
-    
-    void turnCrank(VendingMachine* machine) override {
-        std::cout << "You turned, but there are no balls" << std::endl;
-    }
-    
-    void dispense(VendingMachine* machine) override {
-        std::cout << "No ball dispensed" << std::endl;
-    }
-};
-
 void demonstrateStatePattern();
+void benchmarkVendingMachine(std::size_t transitions = 100'000'000);
 
-#endif // STATE_HPP 
\ No newline at end of file
+#endif // STATE_HPP
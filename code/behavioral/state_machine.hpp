@@ -0,0 +1,88 @@
+#ifndef STATE_MACHINE_HPP
+#define STATE_MACHINE_HPP
+
+#include <array>
+#include <cstddef>
+
+// Number of enumerators in a dense, zero-based enum that ends with Count
+template<typename Enum>
+constexpr std::size_t enumCount = static_cast<std::size_t>(Enum::Count);
+
+// One cell of a transition table: run action, then move to next. With a
+// branch, the target is chosen after the action has run: next when the
+// branch returns true, otherwise when it returns false.
+template<typename State, typename Context>
+struct Transition {
+    State next{};
+    void (*action)(Context&) = nullptr;
+    bool (*branch)(const Context&) = nullptr;
+    State otherwise{};
+};
+
+// Transitions for every (state, event) pair, laid out state-major in one
+// flat array so a lookup is a single multiply-add. Meant to be built in a
+// constexpr initializer; until a cell is set, its event leaves the state
+// unchanged and does nothing.
+template<typename State, typename Event, typename Context>
+class TransitionTable {
+    static constexpr std::size_t kStates = enumCount<State>;
+    static constexpr std::size_t kEvents = enumCount<Event>;
+
+    std::array<Transition<State, Context>, kStates * kEvents> cells_{};
+
+public:
+    constexpr TransitionTable() {
+        for (std::size_t state = 0; state < kStates; ++state) {
+            for (std::size_t event = 0; event < kEvents; ++event) {
+                cells_[state * kEvents + event].next = static_cast<State>(state);
+                cells_[state * kEvents + event].otherwise = static_cast<State>(state);
+            }
+        }
+    }
+
+    constexpr TransitionTable& on(State from, Event event, State to, void (*action)(Context&) = nullptr) {
+        cells_[index(from, event)] = Transition<State, Context>{to, action, nullptr, to};
+        return *this;
+    }
+
+    constexpr TransitionTable& on(State from, Event event, void (*action)(Context&),
+                                  bool (*branch)(const Context&), State ifTrue, State ifFalse) {
+        cells_[index(from, event)] = Transition<State, Context>{ifTrue, action, branch, ifFalse};
+        return *this;
+    }
+
+    constexpr const Transition<State, Context>& at(State from, Event event) const {
+        return cells_[index(from, event)];
+    }
+
+private:
+    static constexpr std::size_t index(State from, Event event) {
+        return static_cast<std::size_t>(from) * kEvents + static_cast<std::size_t>(event);
+    }
+};
+
+// Current state plus the table that drives it. Firing an event is one table
+// lookup and at most two calls through function pointers; nothing is
+// allocated and no state object is created.
+template<typename State, typename Event, typename Context>
+class StateMachine {
+    const TransitionTable<State, Event, Context>& table_;
+    State state_;
+
+public:
+    constexpr StateMachine(const TransitionTable<State, Event, Context>& table, State initial)
+        : table_(table), state_(initial) {}
+
+    void fire(Event event, Context& context) {
+        const Transition<State, Context>& transition = table_.at(state_, event);
+        if (transition.action) {
+            transition.action(context);
+        }
+        state_ = !transition.branch || transition.branch(context) ? transition.next : transition.otherwise;
+    }
+
+    State getState() const { return state_; }
+    void setState(State state) { state_ = state; }
+};
+
+#endif // STATE_MACHINE_HPP
@@ -0,0 +1,439 @@
+#include "station_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+std::vector<std::string_view> splitKey(std::string_view key) {
+    std::vector<std::string_view> segments;
+    std::size_t begin = 0;
+    for (;;) {
+        std::size_t slash = key.find('/', begin);
+        segments.push_back(key.substr(begin, slash - begin));
+        if (slash == std::string_view::npos) {
+            return segments;
+        }
+        begin = slash + 1;
+    }
+}
+
+void validateKey(std::span<const std::string_view> segments) {
+    for (std::string_view segment : segments) {
+        if (segment.empty() || segment == "*" || segment == "#") {
+            throw std::invalid_argument("Station keys need non-empty segments without wildcards");
+        }
+    }
+}
+
+void validatePattern(std::span<const std::string_view> segments) {
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        if (segments[i].empty()) {
+            throw std::invalid_argument("Subscription patterns need non-empty segments");
+        }
+        if (segments[i] == "#" && i + 1 != segments.size()) {
+            throw std::invalid_argument("\"#\" may only be the last segment of a pattern");
+        }
+    }
+}
+
+}
+
+class StationRegistry::StationFeed : public Observer {
+    StationRegistry& registry_;
+    std::string key_;
+    std::vector<std::string_view> segments_;  // views into key_
+
+public:
+    StationFeed(StationRegistry& registry, const std::string& key)
+        : registry_(registry), key_(key), segments_(splitKey(key_)) {}
+
+    void update(float temperature, float humidity, float pressure) override {
+        registry_.route(segments_, [&](Observer& observer) {
+            observer.update(temperature, humidity, pressure);
+        });
+    }
+
+    void updateBatch(std::span<const WeatherReading> readings) override {
+        registry_.route(segments_, [readings](Observer& observer) {
+            observer.updateBatch(readings);
+        });
+    }
+};
+
+StationRegistry::StationRegistry(std::size_t shards) : nextSubscription_(1), delivered_(0) {
+    std::size_t count = shards > 0 ? shards : 1;
+    for (std::size_t i = 0; i < count + 1; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+StationRegistry::~StationRegistry() {
+    for (auto& shard : shards_) {
+        for (auto& [key, entry] : shard->stations) {
+            entry.station->removeObserver(entry.handle);
+        }
+    }
+}
+
+StationRegistry::Shard& StationRegistry::stationShard(std::string_view key) const {
+    return *shards_[SegmentHash{}(key) % (shards_.size() - 1)];
+}
+
+std::size_t StationRegistry::patternShardIndex(std::string_view firstSegment) const {
+    if (firstSegment == "*" || firstSegment == "#") {
+        return shards_.size() - 1;
+    }
+    return SegmentHash{}(firstSegment) % (shards_.size() - 1);
+}
+
+bool StationRegistry::registerStation(const std::string& key, std::shared_ptr<WeatherStation> station) {
+    validateKey(splitKey(key));
+    auto feed = std::make_shared<StationFeed>(*this, key);
+    Shard& shard = stationShard(key);
+    std::unique_lock lock(shard.mutex);
+    auto [it, inserted] = shard.stations.try_emplace(key);
+    if (!inserted) {
+        return false;
+    }
+    ObserverHandle handle = station->registerObserver(feed);
+    it->second = StationEntry{std::move(station), std::move(feed), handle};
+    return true;
+}
+
+bool StationRegistry::unregisterStation(std::string_view key) {
+    Shard& shard = stationShard(key);
+    StationEntry entry;
+    {
+        std::unique_lock lock(shard.mutex);
+        auto it = shard.stations.find(key);
+        if (it == shard.stations.end()) {
+            return false;
+        }
+        entry = std::move(it->second);
+        shard.stations.erase(it);
+    }
+    entry.station->removeObserver(entry.handle);
+    return true;
+}
+
+std::shared_ptr<WeatherStation> StationRegistry::findStation(std::string_view key) const {
+    Shard& shard = stationShard(key);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.stations.find(key);
+    return it != shard.stations.end() ? it->second.station : nullptr;
+}
+
+SubscriptionId StationRegistry::subscribe(const std::string& pattern, std::shared_ptr<Observer> observer) {
+    auto segments = splitKey(pattern);
+    validatePattern(segments);
+
+    // The id encodes its shard, so unsubscribe goes straight to it
+    std::size_t index = patternShardIndex(segments.front());
+    SubscriptionId id = nextSubscription_.fetch_add(1, std::memory_order_relaxed) * shards_.size() + index;
+    Subscriber subscriber{id, std::move(observer)};
+
+    Shard& shard = *shards_[index];
+    std::unique_lock lock(shard.mutex);
+    shard.subscriptions.emplace(id, pattern);
+    if (index != shards_.size() - 1) {
+        insert(shard.patterns, segments, std::move(subscriber));
+        return id;
+    }
+    for (std::size_t i = 0; i + 1 < shards_.size(); ++i) {
+        std::unique_lock patternLock(shards_[i]->mutex);
+        insert(shards_[i]->patterns, segments, subscriber);
+    }
+    return id;
+}
+
+void StationRegistry::insert(PatternNode& root, std::span<const std::string_view> segments,
+                             Subscriber subscriber) {
+    PatternNode* node = &root;
+    for (std::string_view segment : segments) {
+        if (segment == "#") {
+            node->remainder.push_back(std::move(subscriber));
+            return;
+        }
+        auto& child = node->children[std::string(segment)];
+        if (!child) {
+            child = std::make_unique<PatternNode>();
+        }
+        node = child.get();
+    }
+    node->exact.push_back(std::move(subscriber));
+}
+
+bool StationRegistry::unsubscribe(SubscriptionId id) {
+    std::size_t index = id % shards_.size();
+    Shard& shard = *shards_[index];
+    std::unique_lock lock(shard.mutex);
+    auto it = shard.subscriptions.find(id);
+    if (it == shard.subscriptions.end()) {
+        return false;
+    }
+    auto segments = splitKey(it->second);
+    if (index != shards_.size() - 1) {
+        erase(shard.patterns, segments, 0, id);
+    } else {
+        for (std::size_t i = 0; i + 1 < shards_.size(); ++i) {
+            std::unique_lock patternLock(shards_[i]->mutex);
+            erase(shards_[i]->patterns, segments, 0, id);
+        }
+    }
+    shard.subscriptions.erase(it);
+    return true;
+}
+
+// Removes the subscription and prunes nodes left without any
+bool StationRegistry::erase(PatternNode& node, std::span<const std::string_view> segments, std::size_t depth,
+                            SubscriptionId id) {
+    auto removeFrom = [id](std::vector<Subscriber>& subscribers) {
+        auto it = std::find_if(subscribers.begin(), subscribers.end(),
+                               [id](const Subscriber& subscriber) { return subscriber.id == id; });
+        if (it == subscribers.end()) {
+            return false;
+        }
+        *it = std::move(subscribers.back());
+        subscribers.pop_back();
+        return true;
+    };
+
+    if (depth == segments.size()) {
+        return removeFrom(node.exact);
+    }
+    if (segments[depth] == "#") {
+        return removeFrom(node.remainder);
+    }
+    auto it = node.children.find(segments[depth]);
+    if (it == node.children.end()) {
+        return false;
+    }
+    bool removed = erase(*it->second, segments, depth + 1, id);
+    const PatternNode& child = *it->second;
+    if (child.children.empty() && child.exact.empty() && child.remainder.empty()) {
+        node.children.erase(it);
+    }
+    return removed;
+}
+
+void StationRegistry::collect(const PatternNode& node, std::span<const std::string_view> segments,
+                              std::size_t depth, std::vector<std::shared_ptr<Observer>>& observers) {
+    for (const auto& subscriber : node.remainder) {
+        observers.push_back(subscriber.observer);
+    }
+    if (depth == segments.size()) {
+        for (const auto& subscriber : node.exact) {
+            observers.push_back(subscriber.observer);
+        }
+        return;
+    }
+    if (auto it = node.children.find(segments[depth]); it != node.children.end()) {
+        collect(*it->second, segments, depth + 1, observers);
+    }
+    if (auto it = node.children.find(std::string_view("*")); it != node.children.end()) {
+        collect(*it->second, segments, depth + 1, observers);
+    }
+}
+
+std::vector<std::shared_ptr<Observer>> StationRegistry::match(std::span<const std::string_view> segments) const {
+    std::vector<std::shared_ptr<Observer>> observers;
+    {
+        // Station keys never start with a wildcard, so this is never the last shard
+        const Shard& shard = *shards_[patternShardIndex(segments.front())];
+        std::shared_lock lock(shard.mutex);
+        collect(shard.patterns, segments, 0, observers);
+    }
+    if (observers.size() > 1) {
+        // One update per observer, however many of its patterns matched
+        std::sort(observers.begin(), observers.end());
+        observers.erase(std::unique(observers.begin(), observers.end()), observers.end());
+    }
+    return observers;
+}
+
+template<typename Deliver>
+void StationRegistry::route(std::span<const std::string_view> segments, Deliver deliver) {
+    auto observers = match(segments);
+    for (const auto& observer : observers) {
+        deliver(*observer);
+    }
+    delivered_.fetch_add(observers.size(), std::memory_order_relaxed);
+}
+
+void StationRegistry::publish(std::string_view key, float temperature, float humidity, float pressure) {
+    auto segments = splitKey(key);
+    validateKey(segments);
+    route(segments, [&](Observer& observer) {
+        observer.update(temperature, humidity, pressure);
+    });
+}
+
+void StationRegistry::publish(std::string_view key, std::span<const WeatherReading> readings) {
+    auto segments = splitKey(key);
+    validateKey(segments);
+    route(segments, [readings](Observer& observer) {
+        observer.updateBatch(readings);
+    });
+}
+
+std::size_t StationRegistry::getStationCount() const {
+    std::size_t count = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock lock(shard->mutex);
+        count += shard->stations.size();
+    }
+    return count;
+}
+
+std::size_t StationRegistry::getSubscriptionCount() const {
+    std::size_t count = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock lock(shard->mutex);
+        count += shard->subscriptions.size();
+    }
+    return count;
+}
+
+namespace {
+
+// Counts updates; safe to share between publishing threads
+class UpdateCounter : public Observer {
+    std::atomic<std::uint64_t> updates_{0};
+public:
+    void update(float, float, float) override {
+        updates_.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::uint64_t getUpdates() const { return updates_.load(); }
+};
+
+std::string stationKey(std::size_t region, std::size_t site, std::size_t station) {
+    return "region-" + std::to_string(region) + "/site-" + std::to_string(site) + "/station-" +
+           std::to_string(station);
+}
+
+}
+
+void demonstrateStationRegistry() {
+    std::cout << "\n=== Station Registry Demo ===\n" << std::endl;
+
+    StationRegistry registry(4);
+    auto roof = std::make_shared<WeatherStation>();
+    auto park = std::make_shared<WeatherStation>();
+    auto lyon = std::make_shared<WeatherStation>();
+    auto denver = std::make_shared<WeatherStation>();
+    registry.registerStation("eu/paris/roof", roof);
+    registry.registerStation("eu/paris/park", park);
+    registry.registerStation("eu/lyon/airport", lyon);
+    registry.registerStation("us/denver/airport", denver);
+
+    auto paris = std::make_shared<CurrentConditionsDisplay>("Paris Dashboard");
+    auto airports = std::make_shared<UpdateCounter>();
+    auto europe = std::make_shared<UpdateCounter>();
+    registry.subscribe("eu/paris/*", paris);
+    registry.subscribe("*/*/airport", airports);
+    registry.subscribe("eu/#", europe);
+    // Overlaps "eu/#" for Lyon, but Europe still counts each reading once
+    registry.subscribe("eu/lyon/airport", europe);
+
+    roof->setMeasurements(18.5f, 62.0f, 1014.0f);
+    lyon->setMeasurements(21.0f, 48.0f, 1016.0f);
+    denver->setMeasurements(12.0f, 30.0f, 1021.0f);
+    park->setMeasurements(18.9f, 65.0f, 1014.0f);
+
+    std::cout << "Airports received " << airports->getUpdates() << " update(s), Europe "
+              << europe->getUpdates() << "; " << registry.getDeliveredCount() << " deliveries from "
+              << registry.getStationCount() << " stations" << std::endl;
+
+    std::cout << "\n=== End Station Registry Demo ===\n" << std::endl;
+}
+
+void benchmarkStationRegistry(std::size_t stations, std::size_t subscriptions, int rounds) {
+    std::cout << "\n=== Station Registry Benchmark ===\n" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    auto nanos = [](Clock::duration elapsed) {
+        return std::chrono::duration<double, std::nano>(elapsed).count();
+    };
+    constexpr std::size_t kRegions = 20;
+    constexpr std::size_t kSites = 50;
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Same subscription mix at two fleet sizes: per-measurement cost should
+    // not grow with the number of stations
+    for (std::size_t fleet : {stations / 10, stations}) {
+        StationRegistry registry;
+        std::vector<std::shared_ptr<WeatherStation>> fleetStations;
+        std::vector<std::string> keys;
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < fleet; ++i) {
+            keys.push_back(stationKey(i % kRegions, i / kRegions % kSites, i));
+            fleetStations.push_back(std::make_shared<WeatherStation>());
+            registry.registerStation(keys.back(), fleetStations.back());
+        }
+        double registerNanos = nanos(Clock::now() - start);
+
+        // Mostly single stations, then sites, regions and one site everywhere
+        std::mt19937 random(5);
+        std::vector<std::string> patterns;
+        for (std::size_t i = 0; i < subscriptions; ++i) {
+            std::size_t region = random() % kRegions;
+            std::size_t site = random() % kSites;
+            switch (random() % 20) {
+            case 12: case 13: case 14: case 15: case 16:
+                patterns.push_back("region-" + std::to_string(region) + "/site-" + std::to_string(site) + "/*");
+                break;
+            case 17: case 18:
+                patterns.push_back("region-" + std::to_string(region) + "/#");
+                break;
+            case 19:
+                patterns.push_back("*/site-" + std::to_string(site) + "/#");
+                break;
+            default:
+                patterns.push_back(keys[random() % fleet]);
+                break;
+            }
+        }
+        std::vector<std::shared_ptr<UpdateCounter>> dashboards;
+        for (std::size_t i = 0; i < subscriptions; ++i) {
+            dashboards.push_back(std::make_shared<UpdateCounter>());
+        }
+        start = Clock::now();
+        for (std::size_t i = 0; i < subscriptions; ++i) {
+            registry.subscribe(patterns[i], dashboards[i]);
+        }
+        double subscribeNanos = nanos(Clock::now() - start);
+
+        // Every station publishes once per round, stations split over threads
+        start = Clock::now();
+        std::vector<std::thread> publishers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            publishers.emplace_back([&, t]() {
+                for (int round = 0; round < rounds; ++round) {
+                    for (std::size_t i = t; i < fleet; i += threads) {
+                        fleetStations[i]->setMeasurements(20.0f + static_cast<float>(round), 50.0f, 1013.0f);
+                    }
+                }
+            });
+        }
+        for (auto& publisher : publishers) {
+            publisher.join();
+        }
+        double publishNanos = nanos(Clock::now() - start);
+        double measurements = static_cast<double>(fleet) * rounds;
+
+        std::cout << fleet << " stations, " << subscriptions << " subscriptions, " << registry.getShardCount()
+                  << " shards:" << std::endl;
+        std::cout << "  Register: " << registerNanos / static_cast<double>(fleet) << " ns per station" << std::endl;
+        std::cout << "  Subscribe: " << subscribeNanos / static_cast<double>(subscriptions)
+                  << " ns per pattern" << std::endl;
+        std::cout << "  Route: " << publishNanos / measurements << " ns per measurement, "
+                  << static_cast<double>(registry.getDeliveredCount()) / measurements
+                  << " deliveries per measurement" << std::endl;
+    }
+
+    std::cout << "\n=== End Station Registry Benchmark ===\n" << std::endl;
+}
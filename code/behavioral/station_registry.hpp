@@ -0,0 +1,125 @@
+#ifndef STATION_REGISTRY_HPP
+#define STATION_REGISTRY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "observer.hpp"
+
+using SubscriptionId = std::uint64_t;
+
+// Pub-sub registry over many WeatherStation subjects.
+//
+// Stations are registered under '/'-separated keys such as "eu/paris/roof-3".
+// Observers subscribe with a pattern over the same segments, where "*"
+// matches exactly one segment and a final "#" matches whatever follows,
+// including nothing. Each registered station gets one feed observer that
+// routes its measurements to the matching subscribers only; an observer is
+// updated once per measurement however many of its patterns match.
+//
+// Patterns are kept in segment tries, so subscribing and routing cost depends
+// on the key depth and on how many patterns match, not on how many stations
+// there are. The station index and the tries are split over shards, each
+// behind its own reader/writer lock: stations by a hash of the key, patterns
+// by their first segment. Patterns that start with a wildcard are copied into
+// every shard's trie, so routing a measurement takes exactly one shared lock;
+// subscribing to one takes each shard's lock in turn. Matching subscribers
+// are collected under the lock and updated after it is released, so they may
+// subscribe or unsubscribe from update().
+//
+// Stations must not publish while the registry is being destroyed.
+class StationRegistry {
+    struct SegmentHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view segment) const {
+            return std::hash<std::string_view>{}(segment);
+        }
+    };
+
+    struct Subscriber {
+        SubscriptionId id;
+        std::shared_ptr<Observer> observer;
+    };
+
+    struct PatternNode {
+        // Next segment; "*" is stored as an ordinary child
+        std::unordered_map<std::string, std::unique_ptr<PatternNode>, SegmentHash, std::equal_to<>> children;
+        std::vector<Subscriber> exact;      // patterns that end at this node
+        std::vector<Subscriber> remainder;  // patterns that end in "#" here
+    };
+
+    // Observer registered on each station; forwards to publish()
+    class StationFeed;
+
+    struct StationEntry {
+        std::shared_ptr<WeatherStation> station;
+        std::shared_ptr<StationFeed> feed;
+        ObserverHandle handle;
+    };
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        PatternNode patterns;
+        std::unordered_map<SubscriptionId, std::string> subscriptions;
+        std::unordered_map<std::string, StationEntry, SegmentHash, std::equal_to<>> stations;
+    };
+
+    // The last shard only records the subscriptions whose pattern starts with
+    // a wildcard; their trie entries live in all the other shards
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<std::uint64_t> nextSubscription_;
+    std::atomic<std::uint64_t> delivered_;
+
+public:
+    explicit StationRegistry(std::size_t shards = std::thread::hardware_concurrency());
+    ~StationRegistry();
+
+    StationRegistry(const StationRegistry&) = delete;
+    StationRegistry& operator=(const StationRegistry&) = delete;
+
+    // Returns false if the key is taken; throws std::invalid_argument for an
+    // empty segment or a wildcard in the key
+    bool registerStation(const std::string& key, std::shared_ptr<WeatherStation> station);
+    bool unregisterStation(std::string_view key);
+    std::shared_ptr<WeatherStation> findStation(std::string_view key) const;
+
+    // Throws std::invalid_argument for an empty segment or a "#" that is not last
+    SubscriptionId subscribe(const std::string& pattern, std::shared_ptr<Observer> observer);
+    bool unsubscribe(SubscriptionId id);
+
+    // Routes a measurement as if the station under key had published it
+    void publish(std::string_view key, float temperature, float humidity, float pressure);
+    void publish(std::string_view key, std::span<const WeatherReading> readings);
+
+    std::size_t getShardCount() const { return shards_.size() - 1; }
+    std::size_t getStationCount() const;
+    std::size_t getSubscriptionCount() const;
+    std::uint64_t getDeliveredCount() const { return delivered_.load(std::memory_order_relaxed); }
+
+private:
+    Shard& stationShard(std::string_view key) const;
+    std::size_t patternShardIndex(std::string_view firstSegment) const;
+    std::vector<std::shared_ptr<Observer>> match(std::span<const std::string_view> segments) const;
+    static void insert(PatternNode& root, std::span<const std::string_view> segments, Subscriber subscriber);
+    static void collect(const PatternNode& node, std::span<const std::string_view> segments, std::size_t depth,
+                        std::vector<std::shared_ptr<Observer>>& observers);
+    static bool erase(PatternNode& node, std::span<const std::string_view> segments, std::size_t depth,
+                      SubscriptionId id);
+    template<typename Deliver>
+    void route(std::span<const std::string_view> segments, Deliver deliver);
+};
+
+void demonstrateStationRegistry();
+void benchmarkStationRegistry(std::size_t stations = 50'000, std::size_t subscriptions = 10'000,
+                              int rounds = 20);
+
+#endif // STATION_REGISTRY_HPP
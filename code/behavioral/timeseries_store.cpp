@@ -0,0 +1,325 @@
+#include "timeseries_store.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include "observer.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+struct Extent {
+    float min;
+    float max;
+    double sum;
+};
+
+// Min, max and sum of count floats (count > 0)
+Extent scan(const float* values, std::size_t count) {
+    std::size_t i = 0;
+    Extent extent{values[0], values[0], 0.0};
+#if defined(__SSE2__)
+    if (count >= 4) {
+        __m128 low = _mm_loadu_ps(values);
+        __m128 high = low;
+        __m128 sum = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4) {
+            __m128 block = _mm_loadu_ps(values + i);
+            low = _mm_min_ps(low, block);
+            high = _mm_max_ps(high, block);
+            sum = _mm_add_ps(sum, block);
+        }
+        alignas(16) float lanes[3][4];
+        _mm_store_ps(lanes[0], low);
+        _mm_store_ps(lanes[1], high);
+        _mm_store_ps(lanes[2], sum);
+        for (int lane = 0; lane < 4; ++lane) {
+            extent.min = std::min(extent.min, lanes[0][lane]);
+            extent.max = std::max(extent.max, lanes[1][lane]);
+            extent.sum += lanes[2][lane];
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        extent.min = std::min(extent.min, values[i]);
+        extent.max = std::max(extent.max, values[i]);
+        extent.sum += values[i];
+    }
+    return extent;
+}
+
+void merge(RangeAggregate& aggregate, float min, float max, double sum, std::size_t count,
+           double& total) {
+    if (aggregate.count == 0) {
+        aggregate.min = min;
+        aggregate.max = max;
+    } else {
+        aggregate.min = std::min(aggregate.min, min);
+        aggregate.max = std::max(aggregate.max, max);
+    }
+    aggregate.count += count;
+    total += sum;
+}
+
+}
+
+TimeSeriesStore::Chunk::Chunk() : timestamps(new std::int64_t[kChunkSize]) {
+    for (auto& column : columns) {
+        column.reset(new float[kChunkSize]);
+    }
+}
+
+TimeSeriesStore::Chunk& TimeSeriesStore::writableChunk() {
+    if (chunks_.empty() || chunks_.back()->size == kChunkSize) {
+        chunks_.push_back(std::make_unique<Chunk>());
+    }
+    return *chunks_.back();
+}
+
+void TimeSeriesStore::summarize(Chunk& chunk, std::size_t begin) {
+    // Chunks fill in blocks of at most kChunkSize, so summing each block in
+    // float before widening to double keeps the error small
+    for (std::size_t field = 0; field < kFieldCount; ++field) {
+        Extent extent = scan(chunk.columns[field].get() + begin, chunk.size - begin);
+        Summary& summary = chunk.summaries[field];
+        summary.min = std::min(summary.min, extent.min);
+        summary.max = std::max(summary.max, extent.max);
+        summary.sum += extent.sum;
+    }
+}
+
+void TimeSeriesStore::append(std::span<const WeatherReading> readings) {
+    std::int64_t previous = lastTimestamp_;
+    bool ordered = true;
+    for (const auto& reading : readings) {
+        ordered &= reading.timestampNanos >= previous;
+        previous = reading.timestampNanos;
+    }
+    if (!ordered) {
+        throw std::invalid_argument("TimeSeriesStore: readings must be in timestamp order");
+    }
+
+    std::size_t offset = 0;
+    while (offset < readings.size()) {
+        Chunk& chunk = writableChunk();
+        std::size_t begin = chunk.size;
+        std::size_t count = std::min(kChunkSize - begin, readings.size() - offset);
+        const WeatherReading* source = readings.data() + offset;
+        std::int64_t* timestamps = chunk.timestamps.get() + begin;
+        float* temperatures = chunk.columns[0].get() + begin;
+        float* humidities = chunk.columns[1].get() + begin;
+        float* pressures = chunk.columns[2].get() + begin;
+        for (std::size_t i = 0; i < count; ++i) {
+            timestamps[i] = source[i].timestampNanos;
+            temperatures[i] = source[i].temperature;
+            humidities[i] = source[i].humidity;
+            pressures[i] = source[i].pressure;
+        }
+        chunk.size += count;
+        summarize(chunk, begin);
+        offset += count;
+    }
+
+    size_ += readings.size();
+    if (!readings.empty()) {
+        lastTimestamp_ = readings.back().timestampNanos;
+    }
+}
+
+void TimeSeriesStore::append(std::span<const std::int64_t> timestamps, std::span<const float> temperatures,
+                             std::span<const float> humidities, std::span<const float> pressures) {
+    if (temperatures.size() != timestamps.size() || humidities.size() != timestamps.size() ||
+        pressures.size() != timestamps.size()) {
+        throw std::invalid_argument("TimeSeriesStore: column lengths differ");
+    }
+    std::int64_t previous = lastTimestamp_;
+    bool ordered = true;
+    for (std::int64_t timestamp : timestamps) {
+        ordered &= timestamp >= previous;
+        previous = timestamp;
+    }
+    if (!ordered) {
+        throw std::invalid_argument("TimeSeriesStore: readings must be in timestamp order");
+    }
+
+    const float* sources[kFieldCount] = {temperatures.data(), humidities.data(), pressures.data()};
+    std::size_t offset = 0;
+    while (offset < timestamps.size()) {
+        Chunk& chunk = writableChunk();
+        std::size_t begin = chunk.size;
+        std::size_t count = std::min(kChunkSize - begin, timestamps.size() - offset);
+        std::memcpy(chunk.timestamps.get() + begin, timestamps.data() + offset, count * sizeof(std::int64_t));
+        for (std::size_t field = 0; field < kFieldCount; ++field) {
+            std::memcpy(chunk.columns[field].get() + begin, sources[field] + offset, count * sizeof(float));
+        }
+        chunk.size += count;
+        summarize(chunk, begin);
+        offset += count;
+    }
+
+    size_ += timestamps.size();
+    if (!timestamps.empty()) {
+        lastTimestamp_ = timestamps.back();
+    }
+}
+
+WeatherReading TimeSeriesStore::at(std::size_t index) const {
+    const Chunk& chunk = *chunks_.at(index / kChunkSize);
+    std::size_t i = index % kChunkSize;
+    return WeatherReading{chunk.timestamps[i], chunk.columns[0][i], chunk.columns[1][i], chunk.columns[2][i]};
+}
+
+RangeAggregate TimeSeriesStore::aggregate(ReadingField field, std::int64_t from, std::int64_t to) const {
+    RangeAggregate result;
+    if (from >= to) {
+        return result;
+    }
+    auto column = static_cast<std::size_t>(field);
+
+    // First chunk whose last reading is at or after from
+    auto first = std::partition_point(chunks_.begin(), chunks_.end(), [from](const auto& chunk) {
+        return chunk->timestamps[chunk->size - 1] < from;
+    });
+
+    double total = 0.0;
+    for (auto it = first; it != chunks_.end(); ++it) {
+        const Chunk& chunk = **it;
+        const std::int64_t* timestamps = chunk.timestamps.get();
+        if (timestamps[0] >= to) {
+            break;
+        }
+        if (timestamps[0] >= from && timestamps[chunk.size - 1] < to) {
+            const Summary& summary = chunk.summaries[column];
+            merge(result, summary.min, summary.max, summary.sum, chunk.size, total);
+            continue;
+        }
+        std::size_t begin = static_cast<std::size_t>(std::lower_bound(timestamps, timestamps + chunk.size, from) - timestamps);
+        std::size_t end = static_cast<std::size_t>(std::lower_bound(timestamps, timestamps + chunk.size, to) - timestamps);
+        if (begin < end) {
+            Extent extent = scan(chunk.columns[column].get() + begin, end - begin);
+            merge(result, extent.min, extent.max, extent.sum, end - begin, total);
+        }
+    }
+
+    if (result.count > 0) {
+        result.mean = total / static_cast<double>(result.count);
+    }
+    return result;
+}
+
+namespace {
+
+// Counts how often it is notified and how many readings it has seen
+class BatchCountingDisplay : public Observer {
+    std::size_t notifications_ = 0;
+    std::size_t readings_ = 0;
+public:
+    void update(float, float, float) override {
+        ++notifications_;
+        ++readings_;
+    }
+    void updateBatch(std::span<const WeatherReading> readings) override {
+        ++notifications_;
+        readings_ += readings.size();
+    }
+    std::size_t getNotifications() const { return notifications_; }
+    std::size_t getReadings() const { return readings_; }
+};
+
+}
+
+void demonstrateTimeSeriesStore() {
+    std::cout << "\n=== Time Series Store Demo ===\n" << std::endl;
+
+    auto store = std::make_shared<TimeSeriesStore>();
+    WeatherStation station;
+    station.attachStore(store);
+    auto counter = std::make_shared<BatchCountingDisplay>();
+    station.registerObserver(counter);
+
+    // One simulated day at one reading per second, delivered in hourly batches
+    constexpr std::int64_t kSecond = 1'000'000'000;
+    std::vector<WeatherReading> batch;
+    for (int hour = 0; hour < 24; ++hour) {
+        batch.clear();
+        for (int second = 0; second < 3600; ++second) {
+            std::int64_t timestamp = (hour * 3600 + second) * kSecond;
+            float temperature = 12.0f + 8.0f * static_cast<float>(hour) / 23.0f +
+                                static_cast<float>(second % 60) * 0.01f;
+            batch.push_back(WeatherReading{timestamp, temperature, 60.0f - static_cast<float>(hour), 1013.0f});
+        }
+        station.setMeasurements(batch);
+    }
+
+    std::cout << "Stored " << store->size() << " readings in " << store->getChunkCount() << " chunks" << std::endl;
+    std::cout << "Observer notified " << counter->getNotifications() << " times for "
+              << counter->getReadings() << " readings" << std::endl;
+
+    auto morning = store->aggregate(ReadingField::Temperature, 6 * 3600 * kSecond, 12 * 3600 * kSecond);
+    auto evening = store->aggregate(ReadingField::Temperature, 18 * 3600 * kSecond, 24 * 3600 * kSecond);
+    std::cout << "Morning temperature: min " << morning.min << ", max " << morning.max
+              << ", avg " << morning.mean << " over " << morning.count << " readings" << std::endl;
+    std::cout << "Evening temperature: min " << evening.min << ", max " << evening.max
+              << ", avg " << evening.mean << " over " << evening.count << " readings" << std::endl;
+
+    std::cout << "\n=== End Time Series Store Demo ===\n" << std::endl;
+}
+
+void benchmarkTimeSeriesIngest(std::size_t readings) {
+    std::cout << "\n=== Time Series Ingest Benchmark ===\n" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t kBatch = 4096;
+
+    // One batch of input, re-stamped for every append
+    std::vector<WeatherReading> rows(kBatch);
+    std::vector<std::int64_t> timestamps(kBatch);
+    std::vector<float> temperatures(kBatch), humidities(kBatch), pressures(kBatch);
+    for (std::size_t i = 0; i < kBatch; ++i) {
+        float temperature = 15.0f + static_cast<float>(i % 1000) * 0.01f;
+        rows[i] = WeatherReading{0, temperature, 55.0f, 1012.0f};
+        temperatures[i] = temperature;
+        humidities[i] = 55.0f;
+        pressures[i] = 1012.0f;
+    }
+
+    auto run = [&](bool columnar) {
+        TimeSeriesStore store;
+        std::int64_t next = 0;
+        double seconds = 0.0;
+        for (std::size_t done = 0; done < readings; done += kBatch) {
+            std::size_t count = std::min(kBatch, readings - done);
+            for (std::size_t i = 0; i < count; ++i) {
+                rows[i].timestampNanos = timestamps[i] = next++;
+            }
+            auto start = Clock::now();
+            if (columnar) {
+                store.append(std::span(timestamps.data(), count), std::span(temperatures.data(), count),
+                             std::span(humidities.data(), count), std::span(pressures.data(), count));
+            } else {
+                store.append(std::span(rows.data(), count));
+            }
+            seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        std::cout << (columnar ? "Columnar" : "Row") << " batches: " << store.size() << " readings at "
+                  << static_cast<double>(store.size()) / seconds / 1e6 << " M readings/s" << std::endl;
+
+        auto start = Clock::now();
+        auto whole = store.aggregate(ReadingField::Temperature, 0, next);
+        double wholeMicros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        start = Clock::now();
+        auto slice = store.aggregate(ReadingField::Temperature, next / 3 + 17, next / 3 + 17 + 10'000);
+        double sliceMicros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        std::cout << "  Whole range (avg " << whole.mean << "): " << wholeMicros << " us; 10k slice (avg "
+                  << slice.mean << "): " << sliceMicros << " us" << std::endl;
+    };
+
+    run(false);
+    run(true);
+
+    std::cout << "\n=== End Time Series Ingest Benchmark ===\n" << std::endl;
+}
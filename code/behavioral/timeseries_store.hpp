@@ -0,0 +1,87 @@
+#ifndef TIMESERIES_STORE_HPP
+#define TIMESERIES_STORE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+// One timestamped weather measurement
+struct WeatherReading {
+    std::int64_t timestampNanos;
+    float temperature;
+    float humidity;
+    float pressure;
+};
+
+enum class ReadingField {
+    Temperature,
+    Humidity,
+    Pressure
+};
+
+// Result of a range query; all zero when the range holds no readings
+struct RangeAggregate {
+    std::size_t count = 0;
+    float min = 0.0f;
+    float max = 0.0f;
+    double mean = 0.0;
+};
+
+// Columnar, chunked store of weather readings in timestamp order.
+//
+// Each chunk holds kChunkSize readings as four separate arrays (timestamps
+// and one per field), plus a running min/max/sum per field. A range query
+// binary-searches the chunks, takes chunks that lie entirely inside the range
+// straight from their summaries, and scans only the two partial chunks at
+// the edges, four floats at a time with SIMD where available. Chunks never
+// move once allocated. Appends must keep timestamps non-decreasing. Not
+// thread-safe.
+class TimeSeriesStore {
+public:
+    static constexpr std::size_t kChunkSize = 4096;
+    static constexpr std::size_t kFieldCount = 3;
+
+    // Throw std::invalid_argument if the batch would break timestamp order
+    void append(std::span<const WeatherReading> readings);
+    // Same, for readings that are already columnar; all spans must be equally long
+    void append(std::span<const std::int64_t> timestamps, std::span<const float> temperatures,
+                std::span<const float> humidities, std::span<const float> pressures);
+
+    std::size_t size() const { return size_; }
+    std::size_t getChunkCount() const { return chunks_.size(); }
+    WeatherReading at(std::size_t index) const;
+
+    // Aggregates field over readings with from <= timestamp < to
+    RangeAggregate aggregate(ReadingField field, std::int64_t from, std::int64_t to) const;
+
+private:
+    struct Summary {
+        float min = std::numeric_limits<float>::max();
+        float max = std::numeric_limits<float>::lowest();
+        double sum = 0.0;
+    };
+
+    struct Chunk {
+        std::unique_ptr<std::int64_t[]> timestamps;
+        std::array<std::unique_ptr<float[]>, kFieldCount> columns;
+        std::array<Summary, kFieldCount> summaries;
+        std::size_t size = 0;
+        Chunk();
+    };
+
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    std::size_t size_ = 0;
+    std::int64_t lastTimestamp_ = std::numeric_limits<std::int64_t>::min();
+
+    Chunk& writableChunk();
+    static void summarize(Chunk& chunk, std::size_t begin);
+};
+
+void demonstrateTimeSeriesStore();
+void benchmarkTimeSeriesIngest(std::size_t readings = 100'000'000);
+
+#endif // TIMESERIES_STORE_HPP
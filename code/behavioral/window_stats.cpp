@@ -0,0 +1,255 @@
+#include "window_stats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+QuantileSketch::QuantileSketch(double relativeAccuracy)
+    : gamma_((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy)),
+      logGamma_(std::log(gamma_)),
+      positiveOffset_(0), negativeOffset_(0), zeroCount_(0), count_(0) {}
+
+void QuantileSketch::clear() {
+    positive_.clear();
+    negative_.clear();
+    positiveOffset_ = negativeOffset_ = 0;
+    zeroCount_ = count_ = 0;
+}
+
+int QuantileSketch::bucketFor(double magnitude) const {
+    return static_cast<int>(std::ceil(std::log(magnitude) / logGamma_));
+}
+
+double QuantileSketch::bucketValue(int bucket) const {
+    // Midpoint (in relative terms) of (gamma^(k-1), gamma^k]
+    return 2.0 * std::pow(gamma_, bucket) / (gamma_ + 1.0);
+}
+
+void QuantileSketch::adjust(double value, int delta) {
+    count_ += static_cast<std::uint64_t>(static_cast<std::int64_t>(delta));
+    if (value > kMinMagnitude) {
+        adjustStore(positive_, positiveOffset_, bucketFor(value), delta);
+    } else if (value < -kMinMagnitude) {
+        adjustStore(negative_, negativeOffset_, bucketFor(-value), delta);
+    } else {
+        zeroCount_ += static_cast<std::uint64_t>(static_cast<std::int64_t>(delta));
+    }
+}
+
+void QuantileSketch::adjustStore(std::vector<std::uint64_t>& store, int& offset, int bucket, int delta) {
+    if (store.empty()) {
+        store.resize(1, 0);
+        offset = bucket;
+    } else if (bucket < offset) {
+        store.insert(store.begin(), static_cast<std::size_t>(offset - bucket), 0);
+        offset = bucket;
+    } else if (bucket - offset >= static_cast<int>(store.size())) {
+        store.resize(static_cast<std::size_t>(bucket - offset + 1), 0);
+    }
+    store[static_cast<std::size_t>(bucket - offset)] += static_cast<std::uint64_t>(static_cast<std::int64_t>(delta));
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (count_ == 0) {
+        return 0.0;
+    }
+    q = std::clamp(q, 0.0, 1.0);
+    // Nearest rank: the ceil(q * n)-th smallest sample, counting from 1
+    auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count_)));
+    rank = rank > 0 ? std::min(rank, count_) - 1 : 0;
+
+    // Most negative first: negative buckets from the largest magnitude down
+    std::uint64_t seen = 0;
+    for (std::size_t i = negative_.size(); i-- > 0;) {
+        seen += negative_[i];
+        if (seen > rank) {
+            return -bucketValue(negativeOffset_ + static_cast<int>(i));
+        }
+    }
+    seen += zeroCount_;
+    if (seen > rank) {
+        return 0.0;
+    }
+    for (std::size_t i = 0; i < positive_.size(); ++i) {
+        seen += positive_[i];
+        if (seen > rank) {
+            return bucketValue(positiveOffset_ + static_cast<int>(i));
+        }
+    }
+    return positive_.empty() ? 0.0 : bucketValue(positiveOffset_ + static_cast<int>(positive_.size()) - 1);
+}
+
+SlidingWindowStats::SlidingWindowStats(WindowConfig config)
+    : config_(config), samples_(config.maxSamples > 0 ? config.maxSamples + 1 : 16),
+      sketch_(config.quantileAccuracy), nextSequence_(0), total_(0),
+      mean_(0.0), m2_(0.0), evictionsSinceRecompute_(0) {}
+
+void SlidingWindowStats::add(double value, Clock::time_point at) {
+    expire(at);
+    if (config_.maxSamples > 0 && samples_.size() == config_.maxSamples) {
+        evictFront();
+    }
+
+    samples_.pushBack(Sample{value, at});
+    std::uint64_t sequence = nextSequence_++;
+    ++total_;
+
+    // Drop candidates the new sample dominates; they can never be extremes again
+    while (!minimums_.empty() && minimums_.back().value >= value) {
+        minimums_.popBack();
+    }
+    minimums_.pushBack(Candidate{sequence, value});
+    while (!maximums_.empty() && maximums_.back().value <= value) {
+        maximums_.popBack();
+    }
+    maximums_.pushBack(Candidate{sequence, value});
+
+    double delta = value - mean_;
+    mean_ += delta / static_cast<double>(samples_.size());
+    m2_ += delta * (value - mean_);
+
+    sketch_.add(value);
+}
+
+void SlidingWindowStats::expire(Clock::time_point now) {
+    if (config_.maxAge.count() <= 0) {
+        return;
+    }
+    while (!samples_.empty() && now - samples_.front().at > config_.maxAge) {
+        evictFront();
+    }
+}
+
+void SlidingWindowStats::evictFront() {
+    double value = samples_.front().value;
+    std::uint64_t sequence = nextSequence_ - samples_.size();
+    samples_.popFront();
+
+    if (!minimums_.empty() && minimums_.front().sequence == sequence) {
+        minimums_.popFront();
+    }
+    if (!maximums_.empty() && maximums_.front().sequence == sequence) {
+        maximums_.popFront();
+    }
+
+    std::size_t count = samples_.size();
+    if (count == 0) {
+        mean_ = m2_ = 0.0;
+    } else {
+        double delta = value - mean_;
+        mean_ -= delta / static_cast<double>(count);
+        m2_ -= delta * (value - mean_);
+    }
+
+    sketch_.remove(value);
+
+    if (++evictionsSinceRecompute_ >= std::max<std::size_t>(count, 64)) {
+        recompute();
+    }
+}
+
+void SlidingWindowStats::recompute() {
+    mean_ = m2_ = 0.0;
+    for (std::size_t i = 0; i < samples_.size(); ++i) {
+        double value = samples_[i].value;
+        double delta = value - mean_;
+        mean_ += delta / static_cast<double>(i + 1);
+        m2_ += delta * (value - mean_);
+    }
+    evictionsSinceRecompute_ = 0;
+}
+
+double SlidingWindowStats::getVariance() const {
+    std::size_t count = samples_.size();
+    return count < 2 ? 0.0 : std::max(0.0, m2_ / static_cast<double>(count - 1));
+}
+
+double SlidingWindowStats::getStdDev() const {
+    return std::sqrt(getVariance());
+}
+
+double SlidingWindowStats::getPercentile(double percentile) const {
+    // A bucket's representative value can lie just outside the samples in it
+    return std::clamp(sketch_.quantile(percentile / 100.0), getMin(), getMax());
+}
+
+void demonstrateWindowStats() {
+    std::cout << "\n=== Sliding Window Statistics Demo ===\n" << std::endl;
+
+    // Last 5 readings
+    WindowConfig lastFive;
+    lastFive.maxSamples = 5;
+    SlidingWindowStats stats(lastFive);
+    const double readings[] = {21.5, 23.0, 19.8, 25.1, 22.4, 18.9, 24.3, 20.0};
+    for (double reading : readings) {
+        stats.add(reading);
+        std::cout << "Add " << reading << "°C -> window of " << stats.getCount()
+                  << ": min " << stats.getMin() << ", max " << stats.getMax()
+                  << ", mean " << stats.getMean() << ", stddev " << stats.getStdDev()
+                  << ", median " << stats.getPercentile(50) << std::endl;
+    }
+
+    // Last 10 minutes, with simulated timestamps one minute apart
+    WindowConfig tenMinutes;
+    tenMinutes.maxAge = std::chrono::minutes(10);
+    SlidingWindowStats timed(tenMinutes);
+    auto start = SlidingWindowStats::Clock::now();
+    for (int minute = 0; minute < 30; ++minute) {
+        timed.add(15.0 + minute * 0.5, start + std::chrono::minutes(minute));
+    }
+    std::cout << "\nAfter 30 minutes, the 10 minute window holds " << timed.getCount()
+              << " readings from " << timed.getMin() << " to " << timed.getMax() << "°C" << std::endl;
+
+    // Precision: the old running average drifts on a large offset
+    WindowConfig unbounded;
+    SlidingWindowStats precise(unbounded);
+    float runningAverage = 0.0f;
+    for (int i = 0; i < 1'000'000; ++i) {
+        float value = 1000.0f + static_cast<float>(i % 3) * 0.1f;
+        runningAverage = (runningAverage * static_cast<float>(i) + value) / static_cast<float>(i + 1);
+        precise.add(value);
+    }
+    std::cout << "\nMean of 1M readings near 1000.1: running average " << runningAverage
+              << ", Welford " << precise.getMean() << std::endl;
+
+    std::cout << "\n=== End Sliding Window Statistics Demo ===\n" << std::endl;
+}
+
+void benchmarkWindowStats(std::size_t updates) {
+    std::cout << "\n=== Sliding Window Statistics Benchmark ===\n" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    std::mt19937 random(42);
+    std::normal_distribution<double> temperature(20.0, 5.0);
+    std::vector<double> values(1 << 16);
+    for (auto& value : values) {
+        value = temperature(random);
+    }
+
+    WindowConfig config;
+    config.maxSamples = 10'000;
+    config.maxAge = std::chrono::seconds(1);
+    SlidingWindowStats stats(config);
+
+    double checksum = 0.0;
+    auto timestamp = Clock::now();
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < updates; ++i) {
+        // Simulated 1 us spacing, so the time window holds up to a million readings
+        timestamp += std::chrono::microseconds(1);
+        stats.add(values[i & (values.size() - 1)], timestamp);
+        if ((i & 1023) == 0) {
+            checksum += stats.getMin() + stats.getMax() + stats.getStdDev() + stats.getPercentile(99);
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << "Window: last " << config.maxSamples << " readings within 1 s" << std::endl;
+    std::cout << updates << " updates in " << seconds * 1e3 << " ms ("
+              << static_cast<double>(updates) / seconds / 1e6 << " M updates/s)" << std::endl;
+    std::cout << "min " << stats.getMin() << ", max " << stats.getMax() << ", mean " << stats.getMean()
+              << ", stddev " << stats.getStdDev() << ", p50 " << stats.getPercentile(50)
+              << ", p99 " << stats.getPercentile(99) << " (checksum " << checksum << ")" << std::endl;
+
+    std::cout << "\n=== End Sliding Window Statistics Benchmark ===\n" << std::endl;
+}
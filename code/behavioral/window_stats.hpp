@@ -0,0 +1,179 @@
+#ifndef WINDOW_STATS_HPP
+#define WINDOW_STATS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Growable ring buffer; grows by doubling and never shrinks
+template<typename T>
+class RingBuffer {
+    std::unique_ptr<T[]> items_;
+    std::size_t mask_;
+    std::size_t head_;
+    std::size_t size_;
+
+public:
+    explicit RingBuffer(std::size_t capacity = 16) : head_(0), size_(0) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        items_.reset(new T[size]);
+        mask_ = size - 1;
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T& front() { return items_[head_]; }
+    const T& front() const { return items_[head_]; }
+    T& back() { return items_[(head_ + size_ - 1) & mask_]; }
+    const T& back() const { return items_[(head_ + size_ - 1) & mask_]; }
+    const T& operator[](std::size_t index) const { return items_[(head_ + index) & mask_]; }
+
+    void pushBack(const T& item) {
+        if (size_ > mask_) {
+            grow();
+        }
+        items_[(head_ + size_) & mask_] = item;
+        ++size_;
+    }
+
+    void popFront() {
+        head_ = (head_ + 1) & mask_;
+        --size_;
+    }
+
+    void popBack() {
+        --size_;
+    }
+
+    void clear() {
+        head_ = size_ = 0;
+    }
+
+private:
+    void grow() {
+        std::size_t capacity = (mask_ + 1) * 2;
+        std::unique_ptr<T[]> items(new T[capacity]);
+        for (std::size_t i = 0; i < size_; ++i) {
+            items[i] = std::move(items_[(head_ + i) & mask_]);
+        }
+        items_ = std::move(items);
+        mask_ = capacity - 1;
+        head_ = 0;
+    }
+};
+
+// Quantile sketch with relative-error guarantees that supports deletion.
+//
+// Values are counted in logarithmically sized buckets (bucket k covers
+// (gamma^(k-1), gamma^k] with gamma = (1 + a) / (1 - a)), so any quantile is
+// returned within relative accuracy a of a true sample value. add and remove
+// are O(1); quantile walks the buckets, of which there are only a few hundred
+// for any realistic range of values.
+class QuantileSketch {
+    double gamma_;
+    double logGamma_;
+    // Buckets for positive and negative values, indexed from their offset
+    std::vector<std::uint64_t> positive_;
+    std::vector<std::uint64_t> negative_;
+    int positiveOffset_;
+    int negativeOffset_;
+    std::uint64_t zeroCount_;
+    std::uint64_t count_;
+
+public:
+    static constexpr double kMinMagnitude = 1e-9;
+
+    explicit QuantileSketch(double relativeAccuracy = 0.01);
+
+    void add(double value) { adjust(value, 1); }
+    // The value must have been added before
+    void remove(double value) { adjust(value, -1); }
+    void clear();
+
+    // Nearest-rank quantile, q in [0, 1]; returns 0 when empty
+    double quantile(double q) const;
+    std::uint64_t getCount() const { return count_; }
+
+private:
+    int bucketFor(double magnitude) const;
+    double bucketValue(int bucket) const;
+    void adjust(double value, int delta);
+    static void adjustStore(std::vector<std::uint64_t>& store, int& offset, int bucket, int delta);
+};
+
+// Which samples a SlidingWindowStats keeps
+struct WindowConfig {
+    std::size_t maxSamples = 0;             // 0 = no count limit
+    std::chrono::nanoseconds maxAge{0};     // 0 = no age limit
+    double quantileAccuracy = 0.01;
+};
+
+// Statistics over a sliding window of samples, all in O(1) amortized per
+// sample.
+//
+// Min and max come from monotonic deques: each holds the only samples that
+// can still become the extreme before they leave the window. Mean and
+// variance use Welford's update, run in reverse for evictions, and are
+// recomputed from the window whenever it has fully turned over so rounding
+// error cannot accumulate. Percentiles come from a QuantileSketch that
+// evicted samples are removed from.
+class SlidingWindowStats {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Sample {
+        double value = 0.0;
+        Clock::time_point at;
+    };
+
+    struct Candidate {
+        std::uint64_t sequence = 0;
+        double value = 0.0;
+    };
+
+    WindowConfig config_;
+    RingBuffer<Sample> samples_;
+    RingBuffer<Candidate> minimums_;
+    RingBuffer<Candidate> maximums_;
+    QuantileSketch sketch_;
+    std::uint64_t nextSequence_;
+    std::uint64_t total_;
+    double mean_;
+    double m2_;
+    std::size_t evictionsSinceRecompute_;
+
+public:
+    explicit SlidingWindowStats(WindowConfig config = WindowConfig());
+
+    void add(double value, Clock::time_point at = Clock::now());
+    // Evicts samples that have aged out as of now; add() does this too
+    void expire(Clock::time_point now = Clock::now());
+
+    std::size_t getCount() const { return samples_.size(); }
+    std::uint64_t getTotalCount() const { return total_; }
+    double getMin() const { return minimums_.empty() ? 0.0 : minimums_.front().value; }
+    double getMax() const { return maximums_.empty() ? 0.0 : maximums_.front().value; }
+    double getMean() const { return mean_; }
+    // Sample variance; 0 with fewer than two samples
+    double getVariance() const;
+    double getStdDev() const;
+    // percentile in [0, 100]; nearest rank, within [getMin(), getMax()]
+    double getPercentile(double percentile) const;
+
+private:
+    void evictFront();
+    void recompute();
+};
+
+void demonstrateWindowStats();
+void benchmarkWindowStats(std::size_t updates = 10'000'000);
+
+#endif // WINDOW_STATS_HPP
@@ -0,0 +1,139 @@
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+
+namespace {
+
+struct WorkerIdentity {
+    const WorkStealingPool* pool = nullptr;
+    std::size_t index = 0;
+};
+
+thread_local WorkerIdentity currentIdentity;
+
+}
+
+WorkStealingPool::WorkStealingPool(std::size_t threads)
+    : nextWorker_(0), queued_(0), stolen_(0), stopping_(false) {
+    threads = std::max<std::size_t>(1, threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers_[i]->thread = std::thread([this, i]() { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    // Drain first so tasks that submit follow-up tasks are not cut short
+    helpUntil([this]() { return queued_.load(std::memory_order_acquire) == 0; });
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    sleepCondition_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+std::size_t WorkStealingPool::currentWorker() const {
+    return currentIdentity.pool == this ? currentIdentity.index : workers_.size();
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    std::size_t self = currentWorker();
+    std::size_t target = self < workers_.size()
+        ? self
+        : nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    // Counted before it is visible: a thief could otherwise run it and
+    // decrement first, and a drain could see nothing queued
+    queued_.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+        workers_[target]->tasks.push_back(std::move(task));
+    }
+    {
+        // Taking the lock orders this wakeup after a sleeper's last check
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    sleepCondition_.notify_one();
+}
+
+bool WorkStealingPool::runOne(std::size_t self) {
+    std::function<void()> task;
+    if (self < workers_.size()) {
+        Worker& own = *workers_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+    if (!task) {
+        std::size_t count = workers_.size();
+        std::size_t start = self < count ? self + 1 : 0;
+        for (std::size_t k = 0; k < count && !task; ++k) {
+            std::size_t victim = (start + k) % count;
+            if (victim == self) {
+                continue;
+            }
+            Worker& other = *workers_[victim];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            if (!other.tasks.empty()) {
+                task = std::move(other.tasks.front());
+                other.tasks.pop_front();
+                stolen_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    queued_.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+}
+
+void WorkStealingPool::workerLoop(std::size_t index) {
+    currentIdentity = WorkerIdentity{this, index};
+    for (;;) {
+        if (runOne(index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this]() {
+            return stopping_ || queued_.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+void Strand::post(WorkStealingPool& pool, std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(queue_->mutex);
+        queue_->tasks.push_back(std::move(task));
+        if (queue_->running) {
+            return;
+        }
+        queue_->running = true;
+    }
+    pool.submit([queue = queue_]() { drain(*queue); });
+}
+
+void Strand::drain(Queue& queue) {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                queue.running = false;
+                return;
+            }
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        task();
+    }
+}
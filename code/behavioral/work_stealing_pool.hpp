@@ -0,0 +1,87 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool where every worker has its own task deque.
+//
+// A worker pushes and pops its own tasks at the back (most recently split
+// work, still warm in its cache) and, when it runs dry, steals from the
+// front of another worker's deque (the oldest, largest pieces of work).
+// Tasks submitted from outside the pool are spread round-robin. Idle workers
+// sleep on a condition variable.
+class WorkStealingPool {
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<std::size_t> nextWorker_;
+    std::atomic<std::size_t> queued_;
+    std::atomic<std::uint64_t> stolen_;
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    bool stopping_;
+
+public:
+    explicit WorkStealingPool(std::size_t threads = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // Runs queued tasks on the calling thread until done() returns true, so
+    // waiting on the pool from inside a task cannot deadlock it
+    template<typename Done>
+    void helpUntil(Done done) {
+        while (!done()) {
+            if (!runOne(currentWorker())) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    std::size_t getThreadCount() const { return workers_.size(); }
+    std::uint64_t getStolenCount() const { return stolen_.load(std::memory_order_relaxed); }
+
+private:
+    // Index of the calling worker, or getThreadCount() outside the pool
+    std::size_t currentWorker() const;
+    bool runOne(std::size_t self);
+    void workerLoop(std::size_t index);
+};
+
+// Runs posted tasks one at a time, in the order they were posted, on a pool.
+// Tasks on different strands (or plain pool tasks) still run in parallel.
+// The strand may be destroyed with tasks still queued; they run regardless.
+class Strand {
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        bool running = false;
+    };
+
+    // Shared with the draining task rather than reached through this
+    std::shared_ptr<Queue> queue_ = std::make_shared<Queue>();
+
+public:
+    void post(WorkStealingPool& pool, std::function<void()> task);
+
+private:
+    static void drain(Queue& queue);
+};
+
+#endif // WORK_STEALING_POOL_HPP
@@ -7,10 +7,43 @@ void TestBehavioralPatterns()
 	//demonstrateCommandPattern();
 	//demonstrateInterpreterPattern();
 	//demonstrateIteratorPattern();
+	//demonstrateIteratorPipeline();
+	//benchmarkIteratorPipeline();
+	//demonstrateConcurrentAggregate();
+	//benchmarkConcurrentAggregate();
+	//demonstrateMappedAggregate();
+	//benchmarkMappedAggregate();
 	//demonstrateMediatorPattern();
+	//benchmarkMediatorBroadcast();
+	//demonstrateAsyncMediator();
+	//demonstrateShardedMediator();
+	//benchmarkShardedMediator();
+	//demonstrateChatHistory();
+	//demonstrateBatchingMediator();
+	//benchmarkBatchingMediator();
 	//demonstrateMementoPattern();
+	//demonstrateMementoRetention();
+	//demonstrateDeltaMemento();
+	//benchmarkTextEditorSnapshots();
+	//demonstrateTieredCaretaker();
+	//demonstrateAsyncSnapshots();
 	//demonstrateObserverPattern();
+	//demonstrateConcurrentObservers();
+	//benchmarkObserverChurn();
+	//demonstrateParallelNotification();
+	//demonstrateAsyncObservers();
+	//demonstrateFilteredObservers();
+	//demonstrateThrottledObservers();
+	//demonstrateSignalSlot();
+	//benchmarkSignalSlot();
+	//demonstrateStationRegistry();
+	//benchmarkStationRegistry();
+	//demonstrateWindowStats();
+	//benchmarkWindowStats();
+	//demonstrateTimeSeriesStore();
+	//benchmarkTimeSeriesIngest();
 	//demonstrateStatePattern();
+	//benchmarkVendingMachine();
 	//demonstrateStrategyPattern();
 	//demonstrateTemplateMethodPattern();
 	//demonstrateVisitorPattern();